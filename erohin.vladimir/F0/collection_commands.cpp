@@ -1,28 +1,32 @@
 #include "collection_commands.hpp"
+#include <algorithm>
+#include <cctype>
 #include <iostream>
-#include <fstream>
-#include <limits>
 #include "list.hpp"
-#include "string_format.hpp"
 #include "dictionary_record.hpp"
 #include "number_format.hpp"
+#include "record_selection.hpp"
+#include "word_counting.hpp"
 
 
 void erohin::addTextCommand(texts_source & text_context, std::istream & input, std::ostream &)
 {
   std::string text_name[2];
   input >> text_name[0] >> text_name[1];
-  std::fstream file(text_name[1], std::fstream::in);
-  file.close();
-  if (!file)
+  if (text_context.find(text_name[0]) != text_context.end())
   {
-    throw std::runtime_error("addtext: cannot read the file");
+    throw std::logic_error("addtext: bad insertion into texts source");
   }
-  auto iter_pair = text_context.insert(std::make_pair(text_name[0], text_name[1]));
-  if (!iter_pair.second)
+  TextSource text;
+  try
   {
-    throw std::logic_error("addtext: bad insertion into texts source");
+    text = TextSource(text_name[1]);
+  }
+  catch (const std::runtime_error &)
+  {
+    throw std::runtime_error("addtext: cannot read the file");
   }
+  text_context.insert(std::make_pair(text_name[0], std::move(text)));
 }
 
 void erohin::removeTextCommand(texts_source & text_context, std::istream & input, std::ostream &)
@@ -40,10 +44,12 @@ void erohin::removeTextCommand(texts_source & text_context, std::istream & input
 namespace erohin
 {
   bool isNewDictionary(const collection & dict_context, const std::string & new_dict_name);
-  void createDictionary(Dictionary & dict, const std::string & file_name);
+  void storeDictionary(collection & dict_context, const std::string & name, const Dictionary & dict);
+  void storeDictionary(collection & dict_context, const std::string & name, FrozenDictionary && dict);
+  void createDictionary(FrozenDictionary & dict, const TextSource & text, size_t threads_number);
 }
 
-void erohin::createDictCommand(collection & dict_context, const texts_source & text_context, std::istream & input, std::ostream &)
+void erohin::createDictCommand(collection & dict_context, const texts_source & text_context, std::istream & input, std::ostream &, size_t threads_number)
 {
   std::string name[2];
   input >> name[0] >> name[1];
@@ -51,9 +57,9 @@ void erohin::createDictCommand(collection & dict_context, const texts_source & t
   {
     throw std::logic_error("creadict: dictionary has already existed");
   }
-  Dictionary temp_dict;
-  createDictionary(temp_dict, text_context.at(name[1]));
-  dict_context[name[0]] = std::move(temp_dict);
+  FrozenDictionary temp_dict;
+  createDictionary(temp_dict, text_context.at(name[1]), threads_number);
+  storeDictionary(dict_context, name[0], std::move(temp_dict));
 }
 
 void erohin::removeDictCommand(collection & dict_context, std::istream & input, std::ostream &)
@@ -70,14 +76,14 @@ void erohin::removeDictCommand(collection & dict_context, std::istream & input,
 
 namespace erohin
 {
-  void printDictionary(const Dictionary & dict, std::ostream & output, numformat_t numformat);
+  void printDictionary(const FrozenDictionary & dict, std::ostream & output, numformat_t numformat);
 }
 
 void erohin::printCommand(const collection & dict_context, std::istream & input, std::ostream & output, numformat_t numformat)
 {
   std::string dict_name;
   input >> dict_name;
-  const Dictionary & dict = dict_context.at(dict_name);
+  const FrozenDictionary & dict = dict_context.at(dict_name);
   printDictionary(dict, output, numformat);
 }
 
@@ -85,39 +91,57 @@ void erohin::countCommand(const collection & dict_context, std::istream & input,
 {
   std::string dict_name;
   input >> dict_name;
-  const Dictionary & dict = dict_context.at(dict_name);
-  size_t total_number = detail::countTotalNumber(dict.records);
+  const FrozenDictionary & dict = dict_context.at(dict_name);
   size_t unique_number = dict.records.size();
-  output << "words: " << total_number << "; unique words: " << unique_number << "\n";
+  output << "words: " << dict.total_number << "; unique words: " << unique_number << "\n";
 }
 
 namespace erohin
 {
   using sorted_dictionary = RedBlackTree< size_t, List< std::string > >;
-  void createSortedDictionary(sorted_dictionary & sorted_dict, const Dictionary & source);
-  void printSortedDictionary(const sorted_dictionary & sorted_dict, std::ostream & output, numformat_t numformat);
+  void createSortedDictionary(sorted_dictionary & sorted_dict, const FrozenDictionary & source);
+  void printSortedDictionary(const sorted_dictionary & sorted_dict, size_t total_number, std::ostream & output, numformat_t numformat);
+}
+
+namespace erohin
+{
+  bool isOptionalNumberGiven(std::istream & input);
 }
 
 void erohin::sortCommand(const collection & dict_context, std::istream & input, std::ostream & output, numformat_t numformat)
 {
   std::string dict_name;
   input >> dict_name;
-  const Dictionary & dict = dict_context.at(dict_name);
+  const FrozenDictionary & dict = dict_context.at(dict_name);
+  if (isOptionalNumberGiven(input))
+  {
+    size_t num = 0;
+    input >> num;
+    if (!input || !num)
+    {
+      throw std::logic_error("sort: wrong argument input");
+    }
+    selected_records records = selectRecords(dict, num, MoreFrequent{});
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+      output << FormattedRecord(*records[i], dict.total_number, numformat) << "\n";
+    }
+    return;
+  }
   sorted_dictionary sorted_dict;
   createSortedDictionary(sorted_dict, dict);
-  printSortedDictionary(sorted_dict, output, numformat);
+  printSortedDictionary(sorted_dict, dict.total_number, output, numformat);
 }
 
 void erohin::findCommand(const collection & dict_context, std::istream & input, std::ostream & output, numformat_t numformat)
 {
   std::string name[2];
   input >> name[0] >> name[1];
-  const Dictionary & dict = dict_context.at(name[0]);
+  const FrozenDictionary & dict = dict_context.at(name[0]);
   auto found_iter = dict.records.find(name[1]);
   if (found_iter != dict.records.cend())
   {
-    size_t total_number = detail::countTotalNumber(dict.records);
-    output << FormattedRecord(Record(*found_iter), total_number, numformat) << "\n";
+    output << FormattedRecord(Record(*found_iter), dict.total_number, numformat) << "\n";
   }
   else
   {
@@ -125,6 +149,11 @@ void erohin::findCommand(const collection & dict_context, std::istream & input,
   }
 }
 
+namespace erohin
+{
+  void createSelectedDictionary(Dictionary & dict, const selected_records & records);
+}
+
 void erohin::topCommand(collection & dict_context, std::istream & input, std::ostream &)
 {
   std::string dict_name[2];
@@ -134,12 +163,10 @@ void erohin::topCommand(collection & dict_context, std::istream & input, std::os
   {
     throw std::logic_error("top: wrong argument input");
   }
-  const Dictionary & dict = dict_context.at(dict_name[1]);
-  sorted_dictionary sorted_dict;
-  createSortedDictionary(sorted_dict, dict);
+  const FrozenDictionary & dict = dict_context.at(dict_name[1]);
   Dictionary temp_dict;
-  detail::insertNumDifferentRecords(temp_dict.records, num, sorted_dict.crbegin(), sorted_dict.crend());
-  dict_context[dict_name[0]] = std::move(temp_dict);
+  createSelectedDictionary(temp_dict, selectRecords(dict, num, MoreFrequent{}));
+  storeDictionary(dict_context, dict_name[0], temp_dict);
 }
 
 void erohin::bottomCommand(collection & dict_context, std::istream & input, std::ostream &)
@@ -151,20 +178,15 @@ void erohin::bottomCommand(collection & dict_context, std::istream & input, std:
   {
     throw std::logic_error("bottom: wrong argument input");
   }
-  const Dictionary & dict = dict_context.at(dict_name[1]);
-  sorted_dictionary sorted_dict;
-  createSortedDictionary(sorted_dict, dict);
+  const FrozenDictionary & dict = dict_context.at(dict_name[1]);
   Dictionary temp_dict;
-  detail::insertNumDifferentRecords(temp_dict.records, num, sorted_dict.cbegin(), sorted_dict.cend());
-  dict_context[dict_name[0]] = std::move(temp_dict);
+  createSelectedDictionary(temp_dict, selectRecords(dict, num, LessFrequent{}));
+  storeDictionary(dict_context, dict_name[0], temp_dict);
 }
 
 namespace erohin
 {
-  using record_pair = std::pair< std::string, size_t >;
-  using dict_pair = std::pair< Dictionary, Dictionary >;
-  record_pair createDifferenceRecord(const record_pair & pair, const Dictionary & dict);
-  void makeDifference(Dictionary & dict, const dict_pair & source);
+  void makeDifference(FrozenDictionary & dict, const FrozenDictionary & first, const FrozenDictionary & second);
 }
 
 void erohin::differCommand(collection & dict_context, std::istream & input, std::ostream &)
@@ -175,20 +197,20 @@ void erohin::differCommand(collection & dict_context, std::istream & input, std:
   {
     throw std::logic_error("differ: dictionary has already existed");
   }
-  const Dictionary & first_dict = dict_context.at(dict_name[1]);
-  const Dictionary & second_dict = dict_context.at(dict_name[2]);
-  Dictionary temp_dict;
-  makeDifference(temp_dict, std::make_pair(first_dict, second_dict));
+  const FrozenDictionary & first_dict = dict_context.at(dict_name[1]);
+  const FrozenDictionary & second_dict = dict_context.at(dict_name[2]);
+  FrozenDictionary temp_dict;
+  makeDifference(temp_dict, first_dict, second_dict);
   if (temp_dict.records.empty())
   {
     throw std::underflow_error("differ: empty difference of two dictionaries");
   }
-  dict_context[dict_name[0]] = std::move(temp_dict);
+  storeDictionary(dict_context, dict_name[0], std::move(temp_dict));
 }
 
 namespace erohin
 {
-  void makeUnion(Dictionary & dict, const dict_pair & source);
+  void makeUnion(FrozenDictionary & dict, const FrozenDictionary & first, const FrozenDictionary & second);
 }
 
 void erohin::uniteCommand(collection & dict_context, std::istream & input, std::ostream &)
@@ -199,16 +221,16 @@ void erohin::uniteCommand(collection & dict_context, std::istream & input, std::
   {
     throw std::logic_error("unite: dictionary has already existed");
   }
-  const Dictionary & first_dict = dict_context.at(dict_name[1]);
-  const Dictionary & second_dict = dict_context.at(dict_name[2]);
-  Dictionary temp_dict;
-  makeUnion(temp_dict, std::make_pair(first_dict, second_dict));
-  dict_context[dict_name[0]] = std::move(temp_dict);
+  const FrozenDictionary & first_dict = dict_context.at(dict_name[1]);
+  const FrozenDictionary & second_dict = dict_context.at(dict_name[2]);
+  FrozenDictionary temp_dict;
+  makeUnion(temp_dict, first_dict, second_dict);
+  storeDictionary(dict_context, dict_name[0], std::move(temp_dict));
 }
 
 namespace erohin
 {
-  void makeIntersection(Dictionary & dict, const dict_pair & source);
+  void makeIntersection(FrozenDictionary & dict, const FrozenDictionary & first, const FrozenDictionary & second);
 }
 
 void erohin::intersectCommand(collection & dict_context, std::istream & input, std::ostream &)
@@ -219,15 +241,15 @@ void erohin::intersectCommand(collection & dict_context, std::istream & input, s
   {
     throw std::logic_error("intersect: dictionary has already existed");
   }
-  const Dictionary & first_dict = dict_context.at(dict_name[1]);
-  const Dictionary & second_dict = dict_context.at(dict_name[2]);
-  Dictionary temp_dict;
-  makeIntersection(temp_dict, std::make_pair(first_dict, second_dict));
+  const FrozenDictionary & first_dict = dict_context.at(dict_name[1]);
+  const FrozenDictionary & second_dict = dict_context.at(dict_name[2]);
+  FrozenDictionary temp_dict;
+  makeIntersection(temp_dict, first_dict, second_dict);
   if (temp_dict.records.empty())
   {
     throw std::underflow_error("differ: empty difference of two dictionaries");
   }
-  dict_context[dict_name[0]] = std::move(temp_dict);
+  storeDictionary(dict_context, dict_name[0], std::move(temp_dict));
 }
 
 bool erohin::isNewDictionary(const collection & dict_context, const std::string & new_dict_name)
@@ -236,37 +258,28 @@ bool erohin::isNewDictionary(const collection & dict_context, const std::string
   return found_iter == dict_context.cend();
 }
 
-void erohin::createDictionary(Dictionary & dict, const std::string & file_name)
+void erohin::storeDictionary(collection & dict_context, const std::string & name, const Dictionary & dict)
 {
-  std::fstream file;
-  file.open(file_name);
-  if (!file)
-  {
-    throw std::runtime_error("File reading error");
-  }
-  Dictionary temp_dict;
-  std::string word;
-  size_t max_size = std::numeric_limits< size_t >::max();
-  file >> WordInContextFormat{ word, max_size };
-  while (!file.eof())
-  {
-    if (file.fail())
-    {
-      file.clear();
-    }
-    else
-    {
-      ++temp_dict.records[word];
-    }
-    file >> WordInContextFormat{ word, max_size };
-  }
+  FrozenDictionary frozen;
+  freezeDictionary(frozen, dict);
+  storeDictionary(dict_context, name, std::move(frozen));
+}
+
+void erohin::storeDictionary(collection & dict_context, const std::string & name, FrozenDictionary && dict)
+{
+  dict_context[name] = std::move(dict);
+}
+
+void erohin::createDictionary(FrozenDictionary & dict, const TextSource & text, size_t threads_number)
+{
+  FrozenDictionary temp_dict;
+  countWords(temp_dict, text, threads_number);
   dict = std::move(temp_dict);
-  file.close();
 }
 
-void erohin::printDictionary(const Dictionary & dict, std::ostream & output, numformat_t numformat)
+void erohin::printDictionary(const FrozenDictionary & dict, std::ostream & output, numformat_t numformat)
 {
-  size_t total_number = detail::countTotalNumber(dict.records);
+  size_t total_number = dict.total_number;
   auto begin = dict.records.cbegin();
   auto end = dict.records.cend();
   while (begin != end)
@@ -276,7 +289,29 @@ void erohin::printDictionary(const Dictionary & dict, std::ostream & output, num
   }
 }
 
-void erohin::createSortedDictionary(sorted_dictionary & sorted_dict, const Dictionary & source)
+bool erohin::isOptionalNumberGiven(std::istream & input)
+{
+  int c = input.peek();
+  while (c == ' ' || c == '\t')
+  {
+    input.get();
+    c = input.peek();
+  }
+  return std::isdigit(c);
+}
+
+void erohin::createSelectedDictionary(Dictionary & dict, const selected_records & records)
+{
+  Dictionary temp_dict;
+  for (size_t i = 0; i < records.size(); ++i)
+  {
+    temp_dict.records.insert(*records[i]);
+    temp_dict.total_number += records[i]->second;
+  }
+  dict = std::move(temp_dict);
+}
+
+void erohin::createSortedDictionary(sorted_dictionary & sorted_dict, const FrozenDictionary & source)
 {
   auto begin = source.records.cbegin();
   auto end = source.records.cend();
@@ -296,9 +331,8 @@ void erohin::createSortedDictionary(sorted_dictionary & sorted_dict, const Dicti
   sorted_dict = std::move(temp_dict);
 }
 
-void erohin::printSortedDictionary(const sorted_dictionary & sorted_dict, std::ostream & output, numformat_t numformat)
+void erohin::printSortedDictionary(const sorted_dictionary & sorted_dict, size_t total_number, std::ostream & output, numformat_t numformat)
 {
-  size_t total_number = detail::countTotalNumber(sorted_dict);
   auto begin = sorted_dict.crbegin();
   auto end = sorted_dict.crend();
   while (begin != end)
@@ -314,57 +348,83 @@ void erohin::printSortedDictionary(const sorted_dictionary & sorted_dict, std::o
   }
 }
 
-erohin::record_pair erohin::createDifferenceRecord(const record_pair & pair, const Dictionary & dict)
-{
-  auto found_iter = dict.records.find(pair.first);
-  size_t num = found_iter != dict.records.cend() ? found_iter->second : 0;
-  return std::make_pair(pair.first, pair.second - num);
-}
-
-void erohin::makeDifference(Dictionary & dict, const dict_pair & source)
+void erohin::makeDifference(FrozenDictionary & dict, const FrozenDictionary & first, const FrozenDictionary & second)
 {
-  auto begin = source.first.records.cbegin();
-  auto end = source.first.records.cend();
-  while (begin != end)
+  sorted_records sorted;
+  auto first_begin = first.records.cbegin();
+  auto first_end = first.records.cend();
+  auto second_begin = second.records.cbegin();
+  auto second_end = second.records.cend();
+  while (first_begin != first_end)
   {
-    dict.records.insert(createDifferenceRecord(*begin, source.second));
-    ++begin;
+    while (second_begin != second_end && second_begin->first < first_begin->first)
+    {
+      ++second_begin;
+    }
+    size_t num = 0;
+    if (second_begin != second_end && second_begin->first == first_begin->first)
+    {
+      num = second_begin->second;
+    }
+    appendSortedRecord(sorted, first_begin->first, first_begin->second - num);
+    ++first_begin;
   }
+  assignSortedRecords(dict, sorted);
 }
 
-void erohin::makeUnion(Dictionary & dict, const dict_pair & source)
+void erohin::makeUnion(FrozenDictionary & dict, const FrozenDictionary & first, const FrozenDictionary & second)
 {
-  auto begin = source.first.records.cbegin();
-  auto end = source.first.records.cend();
-  while (begin != end)
-  {
-    dict.records[begin->first] += begin->second;
-    ++begin;
-  }
-  begin = source.second.records.cbegin();
-  end = source.second.records.cend();
-  while (begin != end)
+  sorted_records sorted;
+  auto first_begin = first.records.cbegin();
+  auto first_end = first.records.cend();
+  auto second_begin = second.records.cbegin();
+  auto second_end = second.records.cend();
+  while (first_begin != first_end || second_begin != second_end)
   {
-    auto iter_pair = dict.records.insert(*begin);
-    if (!iter_pair.second)
+    if (second_begin == second_end || (first_begin != first_end && first_begin->first < second_begin->first))
     {
-      dict.records[begin->first] += begin->second;
+      appendSortedRecord(sorted, first_begin->first, first_begin->second);
+      ++first_begin;
+    }
+    else if (first_begin == first_end || second_begin->first < first_begin->first)
+    {
+      appendSortedRecord(sorted, second_begin->first, second_begin->second);
+      ++second_begin;
+    }
+    else
+    {
+      appendSortedRecord(sorted, first_begin->first, first_begin->second + second_begin->second);
+      ++first_begin;
+      ++second_begin;
     }
-    ++begin;
   }
+  assignSortedRecords(dict, sorted);
 }
 
-void erohin::makeIntersection(Dictionary & dict, const dict_pair & source)
+void erohin::makeIntersection(FrozenDictionary & dict, const FrozenDictionary & first, const FrozenDictionary & second)
 {
-  auto begin = source.first.records.cbegin();
-  auto end = source.first.records.cend();
-  while (begin != end)
+  sorted_records sorted;
+  auto first_begin = first.records.cbegin();
+  auto first_end = first.records.cend();
+  auto second_begin = second.records.cbegin();
+  auto second_end = second.records.cend();
+  while (first_begin != first_end && second_begin != second_end)
   {
-    auto found_iter = source.second.records.find(begin->first);
-    if (found_iter != source.second.records.cend())
+    if (first_begin->first < second_begin->first)
     {
-      dict.records.insert(std::make_pair(begin->first, std::min(begin->second, found_iter->second)));
+      ++first_begin;
+    }
+    else if (second_begin->first < first_begin->first)
+    {
+      ++second_begin;
+    }
+    else
+    {
+      size_t num = std::min(first_begin->second, second_begin->second);
+      appendSortedRecord(sorted, first_begin->first, num);
+      ++first_begin;
+      ++second_begin;
     }
-    ++begin;
   }
+  assignSortedRecords(dict, sorted);
 }
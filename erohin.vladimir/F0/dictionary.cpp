@@ -4,6 +4,33 @@
 #include "red_black_tree.hpp"
 #include "dictionary_record.hpp"
 
+void erohin::freezeDictionary(FrozenDictionary & frozen, const Dictionary & dict)
+{
+  FrozenDictionary temp_dict;
+  temp_dict.records.freeze(dict.records);
+  temp_dict.total_number = dict.total_number;
+  frozen = std::move(temp_dict);
+}
+
+void erohin::appendSortedRecord(sorted_records & records, const std::string & word, size_t number)
+{
+  records.push_back(std::make_pair(word, number));
+}
+
+void erohin::assignSortedRecords(FrozenDictionary & dict, sorted_records & records)
+{
+  FrozenDictionary temp_dict;
+  auto begin = records.cbegin();
+  auto end = records.cend();
+  while (begin != end)
+  {
+    temp_dict.total_number += begin->second;
+    ++begin;
+  }
+  temp_dict.records.assign_sorted(std::move(records));
+  dict = std::move(temp_dict);
+}
+
 std::istream & erohin::operator>>(std::istream & input, Dictionary & dict)
 {
   std::istream::sentry sentry(input);
@@ -16,25 +43,12 @@ std::istream & erohin::operator>>(std::istream & input, Dictionary & dict)
   input >> record;
   while (input.good())
   {
-    temp_dict.records.insert(record.data);
+    if (temp_dict.records.insert(record.data).second)
+    {
+      temp_dict.total_number += record.data.second;
+    }
     input >> record;
   }
   dict = std::move(temp_dict);
   return input;
 }
-
-std::ostream & erohin::operator<<(std::ostream & output, const Dictionary & dict)
-{
-  std::ostream::sentry sentry(output);
-  if (!sentry)
-  {
-    return output;
-  }
-  auto begin = dict.records.cbegin();
-  auto end = dict.records.cend();
-  while (begin != end)
-  {
-    output << Record(*(begin++)) << "\n";
-  }
-  return output;
-}
@@ -1,19 +1,58 @@
 #ifndef DICTIONARY_HPP
 #define DICTIONARY_HPP
 
-#include <iosfwd>
+#include <iostream>
 #include <string>
 #include "red_black_tree.hpp"
+#include "flat_map.hpp"
+#include "dynamic_array.hpp"
+#include "dictionary_record.hpp"
 
 namespace erohin
 {
-  struct Dictionary
+  template< class Records >
+  struct BasicDictionary
   {
-    RedBlackTree< std::string, size_t > records;
+    Records records;
+    size_t total_number;
+    BasicDictionary();
   };
 
+  using Dictionary = BasicDictionary< RedBlackTree< std::string, size_t > >;
+  using FrozenDictionary = BasicDictionary< FlatMap< std::string, size_t > >;
+
+  void freezeDictionary(FrozenDictionary & frozen, const Dictionary & dict);
+
+  using sorted_records = DynamicArray< std::pair< std::string, size_t > >;
+  void appendSortedRecord(sorted_records & records, const std::string & word, size_t number);
+  void assignSortedRecords(FrozenDictionary & dict, sorted_records & records);
+
   std::istream & operator>>(std::istream & input, Dictionary & dict);
-  std::ostream & operator<<(std::ostream & output, const Dictionary & dict);
+  template< class Records >
+  std::ostream & operator<<(std::ostream & output, const BasicDictionary< Records > & dict);
+
+  template< class Records >
+  BasicDictionary< Records >::BasicDictionary():
+    records(),
+    total_number(0)
+  {}
+
+  template< class Records >
+  std::ostream & operator<<(std::ostream & output, const BasicDictionary< Records > & dict)
+  {
+    std::ostream::sentry sentry(output);
+    if (!sentry)
+    {
+      return output;
+    }
+    auto begin = dict.records.cbegin();
+    auto end = dict.records.cend();
+    while (begin != end)
+    {
+      output << Record(*(begin++)) << "\n";
+    }
+    return output;
+  }
 }
 
 #endif
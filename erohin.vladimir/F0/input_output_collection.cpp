@@ -10,7 +10,9 @@ void erohin::inputCollection(collection & dict_context, std::istream & input)
   input >> StringFormat{ dict_name, ':' };
   while (input.good())
   {
-    input >> dict_context[dict_name];
+    Dictionary dict;
+    input >> dict;
+    freezeDictionary(dict_context[dict_name], dict);
     if (!input)
     {
       input.clear();
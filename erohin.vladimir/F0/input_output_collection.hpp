@@ -8,7 +8,7 @@
 
 namespace erohin
 {
-  using collection = RedBlackTree< std::string, Dictionary >;
+  using collection = RedBlackTree< std::string, FrozenDictionary >;
 
   void inputCollection(collection & dict_context, std::istream & input);
   void outputCollection(const collection & dict_context, std::ostream & output);
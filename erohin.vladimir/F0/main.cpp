@@ -22,10 +22,16 @@ int main(int argc, char ** argv)
     return 0;
   }
   numformat_t used_numformat = NUMBER;
-  if (argc == 3)
+  size_t threads_number = 1;
+  if (argc < 2 || argc > 4)
   {
-    std::string format_arg(argv[1]);
-    if (format_arg.substr(0, 12) == "--numformat=")
+    std::cerr << "Wrong CLA's number\n";
+    return 3;
+  }
+  for (int i = 1; i < argc - 1; ++i)
+  {
+    std::string arg(argv[i]);
+    if (arg.substr(0, 12) == "--numformat=")
     {
       RedBlackTree< std::string, numformat_t > format;
       format["NUMBER"] = NUMBER;
@@ -34,7 +40,7 @@ int main(int argc, char ** argv)
       format["PERCENTAGE"] = PERCENTAGE;
       try
       {
-        used_numformat = format.at(format_arg.substr(12));
+        used_numformat = format.at(arg.substr(12));
       }
       catch (const std::out_of_range &)
       {
@@ -42,17 +48,29 @@ int main(int argc, char ** argv)
         return 1;
       }
     }
+    else if (arg.substr(0, 10) == "--threads=")
+    {
+      std::string value = arg.substr(10);
+      try
+      {
+        threads_number = std::stoul(value);
+      }
+      catch (const std::exception &)
+      {
+        threads_number = 0;
+      }
+      if (value.find_first_not_of("0123456789") != std::string::npos || threads_number == 0)
+      {
+        std::cerr << "Wrong number of threads\n";
+        return 4;
+      }
+    }
     else
     {
-      std::cerr << "Wrong CLA to identify numformat\n";
+      std::cerr << "Wrong CLA to identify option\n";
       return 2;
     }
   }
-  else if (argc != 2)
-  {
-    std::cerr << "Wrong CLA's number\n";
-    return 3;
-  }
   std::fstream file(argv[argc - 1], std::ios::in);
   collection dict_context;
   inputCollection(dict_context, file);
@@ -64,7 +82,7 @@ int main(int argc, char ** argv)
     using namespace std::placeholders;
     command["addtext"] = std::bind(addTextCommand, std::ref(text_context), _1, _2);
     command["removetext"] = std::bind(removeTextCommand, std::ref(text_context), _1, _2);
-    command["createdict"] = std::bind(createDictCommand, std::ref(dict_context), std::cref(text_context), _1, _2);
+    command["createdict"] = std::bind(createDictCommand, std::ref(dict_context), std::cref(text_context), _1, _2, threads_number);
     command["removedict"] = std::bind(removeDictCommand, std::ref(dict_context), _1, _2);
     command["print"] = std::bind(printCommand, std::cref(dict_context), _1, _2, used_numformat);
     command["count"] = std::bind(countCommand, std::cref(dict_context), _1, _2);
@@ -0,0 +1,11 @@
+#include "record_selection.hpp"
+
+bool erohin::MoreFrequent::operator()(const std::pair< std::string, size_t > & lhs, const std::pair< std::string, size_t > & rhs) const
+{
+  return (lhs.second > rhs.second) || (lhs.second == rhs.second && lhs.first < rhs.first);
+}
+
+bool erohin::LessFrequent::operator()(const std::pair< std::string, size_t > & lhs, const std::pair< std::string, size_t > & rhs) const
+{
+  return (lhs.second < rhs.second) || (lhs.second == rhs.second && lhs.first < rhs.first);
+}
@@ -0,0 +1,104 @@
+#ifndef RECORD_SELECTION_HPP
+#define RECORD_SELECTION_HPP
+
+#include <memory>
+#include <string>
+#include <utility>
+#include "dynamic_array.hpp"
+#include "dictionary.hpp"
+
+namespace erohin
+{
+  using selected_records = DynamicArray< const std::pair< std::string, size_t > * >;
+
+  struct MoreFrequent
+  {
+    bool operator()(const std::pair< std::string, size_t > & lhs, const std::pair< std::string, size_t > & rhs) const;
+  };
+
+  struct LessFrequent
+  {
+    bool operator()(const std::pair< std::string, size_t > & lhs, const std::pair< std::string, size_t > & rhs) const;
+  };
+
+  namespace detail
+  {
+    template< class Compare >
+    void siftUp(selected_records & heap, size_t index, Compare is_better)
+    {
+      while (index > 0)
+      {
+        size_t parent = (index - 1) / 2;
+        if (!is_better(*heap[parent], *heap[index]))
+        {
+          return;
+        }
+        std::swap(heap[parent], heap[index]);
+        index = parent;
+      }
+    }
+
+    template< class Compare >
+    void siftDown(selected_records & heap, size_t index, Compare is_better)
+    {
+      size_t size = heap.size();
+      while (2 * index + 1 < size)
+      {
+        size_t worst = 2 * index + 1;
+        if (worst + 1 < size && is_better(*heap[worst], *heap[worst + 1]))
+        {
+          ++worst;
+        }
+        if (!is_better(*heap[index], *heap[worst]))
+        {
+          return;
+        }
+        std::swap(heap[index], heap[worst]);
+        index = worst;
+      }
+    }
+  }
+
+  template< class Records, class Compare >
+  selected_records selectRecords(const BasicDictionary< Records > & dict, size_t count, Compare is_better)
+  {
+    selected_records heap;
+    if (count == 0)
+    {
+      return heap;
+    }
+    auto begin = dict.records.cbegin();
+    auto end = dict.records.cend();
+    while (begin != end)
+    {
+      const std::pair< std::string, size_t > * record = std::addressof(*begin);
+      if (heap.size() < count)
+      {
+        heap.push_back(record);
+        detail::siftUp(heap, heap.size() - 1, is_better);
+      }
+      else if (is_better(*record, *heap.front()))
+      {
+        heap.front() = record;
+        detail::siftDown(heap, 0, is_better);
+      }
+      ++begin;
+    }
+    selected_records result;
+    while (!heap.empty())
+    {
+      result.push_back(heap.front());
+      heap.front() = heap.back();
+      heap.pop_back();
+      detail::siftDown(heap, 0, is_better);
+    }
+    size_t size = result.size();
+    for (size_t i = 0; i < size / 2; ++i)
+    {
+      std::swap(result[i], result[size - i - 1]);
+    }
+    return result;
+  }
+}
+
+#endif
@@ -12,7 +12,8 @@ void erohin::printHelp(std::ostream & output)
   output << "\t--help — show this help\n";
   output << "\t--check — check file <freqdict> correctness\n";
   output << "\t--numformat=<format> — starting with use a file <freqdict> with style <format>\n";
-  output << "\t<format> = { NUMBER, PROPORTION, FRACTIONAL, PERCANTAGE }\n\n";
+  output << "\t<format> = { NUMBER, PROPORTION, FRACTIONAL, PERCANTAGE }\n";
+  output << "\t--threads=<number> — count words of a text for createdict in <number> threads\n\n";
   output << "Commands:\n";
   output << "\t1. addtext <text> <source>\n";
   output << "\tAdd a text named <text>, read from the <source> file.\n\n";
@@ -26,8 +27,9 @@ void erohin::printHelp(std::ostream & output)
   output << "\tPrint a frequency dictionary named <dict>.\n\n";
   output << "\t6. count <dict>\n";
   output << "\tPrint the total number of words and the number of unique words in the dictionary <dict>.\n\n";
-  output << "\t7. sort <dict>\n";
-  output << "\tPrint a frequency dictionary <dict> sorted by the frequency of words.\n\n";
+  output << "\t7. sort <dict> [<number>]\n";
+  output << "\tPrint a frequency dictionary <dict> sorted by the frequency of words. ";
+  output << "If <number> is given, print only the <number> most frequent words.\n\n";
   output << "\t8. find <dict> <word>\n";
   output << "\tFind the word <word> in the frequency dictionary <dict> and print its frequency.\n\n";
   output << "\t9. top <new_dict> <dict> <top_number>\n";
@@ -51,3 +51,60 @@ std::istream & erohin::operator>>(std::istream & input, WordInContextFormat && d
   }
   return input;
 }
+
+namespace erohin
+{
+  bool isSpace(char c);
+  bool isAlpha(char c);
+}
+
+bool erohin::readWord(const char *& current, const char * end, WordSlice & word)
+{
+  while (current != end)
+  {
+    while (current != end && isSpace(*current))
+    {
+      ++current;
+    }
+    const char * token_begin = current;
+    while (current != end && !isSpace(*current))
+    {
+      ++current;
+    }
+    const char * token_end = current;
+    while (token_begin != token_end && !isAlpha(*token_begin))
+    {
+      ++token_begin;
+    }
+    while (token_begin != token_end && !isAlpha(*(token_end - 1)))
+    {
+      --token_end;
+    }
+    if (token_begin != token_end)
+    {
+      word.data = token_begin;
+      word.size = token_end - token_begin;
+      return true;
+    }
+  }
+  return false;
+}
+
+void erohin::assignLowerWord(std::string & dest, const WordSlice & word)
+{
+  dest.assign(word.data, word.size);
+  for (size_t i = 0; i < dest.size(); ++i)
+  {
+    dest[i] = std::tolower(dest[i]);
+  }
+}
+
+bool erohin::isSpace(char c)
+{
+  return std::isspace(static_cast< unsigned char >(c));
+}
+
+bool erohin::isAlpha(char c)
+{
+  return std::isalpha(static_cast< unsigned char >(c));
+}
@@ -18,6 +18,15 @@ namespace erohin
     size_t max_wrapper_size = 0;
   };
 
+  struct WordSlice
+  {
+    const char * data;
+    size_t size;
+  };
+
+  bool readWord(const char *& current, const char * end, WordSlice & word);
+  void assignLowerWord(std::string & dest, const WordSlice & word);
+
   std::istream & operator>>(std::istream & input, StringFormat && dest);
   std::istream & operator>>(std::istream & input, WordInContextFormat && dest);
 }
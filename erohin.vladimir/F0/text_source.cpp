@@ -0,0 +1,130 @@
+#include "text_source.hpp"
+#include <stdexcept>
+#include <memory>
+#include <utility>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define EROHIN_HAS_MMAP
+#else
+#include <fstream>
+#endif
+
+erohin::TextSource::TextSource():
+  file_name_(),
+  data_(nullptr),
+  size_(0)
+{}
+
+#ifdef EROHIN_HAS_MMAP
+erohin::TextSource::TextSource(const std::string & file_name):
+  file_name_(file_name),
+  data_(nullptr),
+  size_(0)
+{
+  int fd = ::open(file_name.c_str(), O_RDONLY);
+  if (fd == -1)
+  {
+    throw std::runtime_error("Cannot open text file");
+  }
+  struct stat file_stat;
+  if (::fstat(fd, &file_stat) == -1 || !S_ISREG(file_stat.st_mode))
+  {
+    ::close(fd);
+    throw std::runtime_error("Cannot read text file");
+  }
+  size_ = static_cast< size_t >(file_stat.st_size);
+  if (size_ > 0)
+  {
+    void * mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED)
+    {
+      ::close(fd);
+      throw std::runtime_error("Cannot map text file");
+    }
+    data_ = static_cast< char * >(mapped);
+  }
+  ::close(fd);
+}
+
+void erohin::TextSource::unmap() noexcept
+{
+  if (data_)
+  {
+    ::munmap(data_, size_);
+  }
+}
+#else
+erohin::TextSource::TextSource(const std::string & file_name):
+  file_name_(file_name),
+  data_(nullptr),
+  size_(0)
+{
+  std::ifstream file(file_name, std::ios::binary | std::ios::ate);
+  if (!file)
+  {
+    throw std::runtime_error("Cannot open text file");
+  }
+  size_ = static_cast< size_t >(file.tellg());
+  data_ = new char[size_ + 1];
+  file.seekg(0);
+  if (!file.read(data_, size_))
+  {
+    delete [] data_;
+    throw std::runtime_error("Cannot read text file");
+  }
+}
+
+void erohin::TextSource::unmap() noexcept
+{
+  delete [] data_;
+}
+#endif
+
+erohin::TextSource::TextSource(TextSource && rhs) noexcept:
+  file_name_(std::move(rhs.file_name_)),
+  data_(rhs.data_),
+  size_(rhs.size_)
+{
+  rhs.data_ = nullptr;
+  rhs.size_ = 0;
+}
+
+erohin::TextSource::~TextSource()
+{
+  unmap();
+}
+
+erohin::TextSource & erohin::TextSource::operator=(TextSource && rhs) noexcept
+{
+  if (this != std::addressof(rhs))
+  {
+    TextSource temp(std::move(rhs));
+    swap(temp);
+  }
+  return *this;
+}
+
+const std::string & erohin::TextSource::name() const noexcept
+{
+  return file_name_;
+}
+
+const char * erohin::TextSource::data() const noexcept
+{
+  return data_;
+}
+
+size_t erohin::TextSource::size() const noexcept
+{
+  return size_;
+}
+
+void erohin::TextSource::swap(TextSource & rhs) noexcept
+{
+  std::swap(file_name_, rhs.file_name_);
+  std::swap(data_, rhs.data_);
+  std::swap(size_, rhs.size_);
+}
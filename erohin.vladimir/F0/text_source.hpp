@@ -0,0 +1,30 @@
+#ifndef TEXT_SOURCE_HPP
+#define TEXT_SOURCE_HPP
+
+#include <string>
+
+namespace erohin
+{
+  class TextSource
+  {
+  public:
+    TextSource();
+    explicit TextSource(const std::string & file_name);
+    TextSource(const TextSource &) = delete;
+    TextSource(TextSource && rhs) noexcept;
+    ~TextSource();
+    TextSource & operator=(const TextSource &) = delete;
+    TextSource & operator=(TextSource && rhs) noexcept;
+    const std::string & name() const noexcept;
+    const char * data() const noexcept;
+    size_t size() const noexcept;
+    void swap(TextSource & rhs) noexcept;
+  private:
+    std::string file_name_;
+    char * data_;
+    size_t size_;
+    void unmap() noexcept;
+  };
+}
+
+#endif
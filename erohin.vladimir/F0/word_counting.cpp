@@ -0,0 +1,217 @@
+#include "word_counting.hpp"
+#include <algorithm>
+#include <cctype>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include "string_format.hpp"
+
+void erohin::countWords(Dictionary & dict, const char * begin, const char * end)
+{
+  std::string word;
+  WordSlice slice{ nullptr, 0 };
+  while (readWord(begin, end, slice))
+  {
+    assignLowerWord(word, slice);
+    auto found_iter = dict.records.find(word);
+    if (found_iter != dict.records.end())
+    {
+      ++found_iter->second;
+    }
+    else
+    {
+      dict.records.insert(std::make_pair(word, 1));
+    }
+    ++dict.total_number;
+  }
+}
+
+namespace erohin
+{
+  using records_citerator = RedBlackTree< std::string, size_t >::const_iterator;
+  constexpr size_t max_threads_number = 64;
+  size_t limitThreads(size_t threads_number);
+  void siftHeadUp(DynamicArray< size_t > & heap, size_t index, const DynamicArray< records_citerator > & heads);
+  void siftHeadDown(DynamicArray< size_t > & heap, size_t index, const DynamicArray< records_citerator > & heads);
+  size_t findChunkEnd(const TextSource & text, size_t pos);
+  void countChunk(Dictionary & dict, const char * begin, const char * end, std::exception_ptr & error);
+  void joinWorkers(DynamicArray< std::thread > & workers);
+}
+
+void erohin::countWords(FrozenDictionary & dict, const TextSource & text, size_t threads_number)
+{
+  threads_number = limitThreads(threads_number);
+  if (threads_number <= 1)
+  {
+    Dictionary temp_dict;
+    countWords(temp_dict, text.data(), text.data() + text.size());
+    freezeDictionary(dict, temp_dict);
+    return;
+  }
+  size_t chunk_size = text.size() / threads_number + 1;
+  DynamicArray< size_t > bounds;
+  bounds.push_back(0);
+  while (bounds.back() < text.size())
+  {
+    bounds.push_back(findChunkEnd(text, bounds.back() + chunk_size));
+  }
+  size_t chunks_number = bounds.size() - 1;
+  DynamicArray< Dictionary > parts;
+  DynamicArray< std::exception_ptr > errors;
+  for (size_t i = 0; i < chunks_number; ++i)
+  {
+    parts.push_back(Dictionary());
+    errors.push_back(std::exception_ptr());
+  }
+  DynamicArray< std::thread > workers;
+  try
+  {
+    for (size_t i = 1; i < chunks_number; ++i)
+    {
+      const char * begin = text.data() + bounds[i];
+      const char * end = text.data() + bounds[i + 1];
+      std::thread worker(countChunk, std::ref(parts[i]), begin, end, std::ref(errors[i]));
+      try
+      {
+        workers.push_back(std::move(worker));
+      }
+      catch (...)
+      {
+        if (worker.joinable())
+        {
+          worker.join();
+        }
+        throw;
+      }
+    }
+  }
+  catch (...)
+  {
+    joinWorkers(workers);
+    throw;
+  }
+  if (chunks_number > 0)
+  {
+    countChunk(parts[0], text.data() + bounds[0], text.data() + bounds[1], errors[0]);
+  }
+  joinWorkers(workers);
+  for (size_t i = 0; i < errors.size(); ++i)
+  {
+    if (errors[i])
+    {
+      std::rethrow_exception(errors[i]);
+    }
+  }
+  mergeCounts(dict, parts);
+}
+
+void erohin::mergeCounts(FrozenDictionary & dict, DynamicArray< Dictionary > & parts)
+{
+  DynamicArray< records_citerator > heads;
+  DynamicArray< size_t > heap;
+  for (size_t i = 0; i < parts.size(); ++i)
+  {
+    heads.push_back(parts[i].records.cbegin());
+    if (heads[i] != parts[i].records.cend())
+    {
+      heap.push_back(i);
+      siftHeadUp(heap, heap.size() - 1, heads);
+    }
+  }
+  sorted_records sorted;
+  while (!heap.empty())
+  {
+    size_t part = heap.front();
+    const std::pair< std::string, size_t > & record = *heads[part];
+    if (!sorted.empty() && sorted.back().first == record.first)
+    {
+      sorted.back().second += record.second;
+    }
+    else
+    {
+      appendSortedRecord(sorted, record.first, record.second);
+    }
+    if (++heads[part] == parts[part].records.cend())
+    {
+      heap.front() = heap.back();
+      heap.pop_back();
+    }
+    siftHeadDown(heap, 0, heads);
+  }
+  assignSortedRecords(dict, sorted);
+}
+
+size_t erohin::limitThreads(size_t threads_number)
+{
+  size_t hardware_number = std::thread::hardware_concurrency();
+  size_t limit = std::min(std::max< size_t >(hardware_number, 1), max_threads_number);
+  return std::min(threads_number, limit);
+}
+
+void erohin::siftHeadUp(DynamicArray< size_t > & heap, size_t index, const DynamicArray< records_citerator > & heads)
+{
+  while (index > 0)
+  {
+    size_t parent = (index - 1) / 2;
+    if (!(heads[heap[index]]->first < heads[heap[parent]]->first))
+    {
+      return;
+    }
+    std::swap(heap[parent], heap[index]);
+    index = parent;
+  }
+}
+
+void erohin::siftHeadDown(DynamicArray< size_t > & heap, size_t index, const DynamicArray< records_citerator > & heads)
+{
+  size_t size = heap.size();
+  while (2 * index + 1 < size)
+  {
+    size_t least = 2 * index + 1;
+    if (least + 1 < size && heads[heap[least + 1]]->first < heads[heap[least]]->first)
+    {
+      ++least;
+    }
+    if (!(heads[heap[least]]->first < heads[heap[index]]->first))
+    {
+      return;
+    }
+    std::swap(heap[index], heap[least]);
+    index = least;
+  }
+}
+
+size_t erohin::findChunkEnd(const TextSource & text, size_t pos)
+{
+  const char * data = text.data();
+  while (pos < text.size() && !std::isspace(static_cast< unsigned char >(data[pos])))
+  {
+    ++pos;
+  }
+  return (pos < text.size()) ? pos : text.size();
+}
+
+void erohin::countChunk(Dictionary & dict, const char * begin, const char * end, std::exception_ptr & error)
+{
+  try
+  {
+    countWords(dict, begin, end);
+  }
+  catch (...)
+  {
+    error = std::current_exception();
+  }
+}
+
+void erohin::joinWorkers(DynamicArray< std::thread > & workers)
+{
+  for (size_t i = 0; i < workers.size(); ++i)
+  {
+    if (workers[i].joinable())
+    {
+      workers[i].join();
+    }
+  }
+}
@@ -0,0 +1,15 @@
+#ifndef WORD_COUNTING_HPP
+#define WORD_COUNTING_HPP
+
+#include "dictionary.hpp"
+#include "dynamic_array.hpp"
+#include "text_source.hpp"
+
+namespace erohin
+{
+  void countWords(Dictionary & dict, const char * begin, const char * end);
+  void countWords(FrozenDictionary & dict, const TextSource & text, size_t threads_number);
+  void mergeCounts(FrozenDictionary & dict, DynamicArray< Dictionary > & parts);
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef BREADTH_LEVEL_HPP
+#define BREADTH_LEVEL_HPP
+
+#include <cstddef>
+#include <memory>
+#include "dynamic_array.hpp"
+
+namespace erohin
+{
+  namespace detail
+  {
+    template< class Node >
+    using breadth_level = std::shared_ptr< const DynamicArray< Node * > >;
+
+    template< class Node >
+    breadth_level< Node > makeRootLevel(Node * root)
+    {
+      auto level = std::make_shared< DynamicArray< Node * > >();
+      level->push_back(root);
+      return level;
+    }
+
+    template< class Node >
+    breadth_level< Node > makeNextLevel(const DynamicArray< Node * > & level)
+    {
+      auto next_level = std::make_shared< DynamicArray< Node * > >();
+      for (size_t i = 0; i < level.size(); ++i)
+      {
+        if (level[i]->left)
+        {
+          next_level->push_back(level[i]->left);
+        }
+        if (level[i]->right)
+        {
+          next_level->push_back(level[i]->right);
+        }
+      }
+      return next_level;
+    }
+
+    template< class Node >
+    void collectLevel(Node * node, size_t depth, DynamicArray< Node * > & level)
+    {
+      if (!node)
+      {
+        return;
+      }
+      if (depth == 0)
+      {
+        level.push_back(node);
+        return;
+      }
+      collectLevel< Node >(node->left, depth - 1, level);
+      collectLevel< Node >(node->right, depth - 1, level);
+    }
+
+    template< class Node >
+    breadth_level< Node > makeLevel(Node * root, size_t depth)
+    {
+      auto level = std::make_shared< DynamicArray< Node * > >();
+      collectLevel(root, depth, *level);
+      return level;
+    }
+  }
+}
+
+#endif
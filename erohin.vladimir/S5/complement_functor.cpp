@@ -4,22 +4,39 @@
 #include <stdexcept>
 
 erohin::ComplementFunctor::ComplementFunctor():
-  sum(0)
+  sum(0),
+  is_sum_known(false)
 {}
 
+erohin::ComplementFunctor::ComplementFunctor(size_t names_length):
+  ComplementFunctor()
+{
+  names.reserve(names_length);
+}
+
+erohin::ComplementFunctor::ComplementFunctor(int known_sum, size_t names_length):
+  ComplementFunctor(names_length)
+{
+  sum = known_sum;
+  is_sum_known = true;
+}
+
 erohin::ComplementFunctor::~ComplementFunctor() = default;
 
-erohin::ComplementFunctor erohin::ComplementFunctor::operator()(const std::pair< int, std::string > & pair)
+void erohin::ComplementFunctor::operator()(const std::pair< int, std::string > & pair)
 {
-  if (sum > 0 && std::numeric_limits< int >::max() - sum < pair.first)
-  {
-    throw std::overflow_error("Overflow of number");
-  }
-  else if (sum < 0 && pair.first < 0 && std::numeric_limits< int >::min() - sum > pair.first)
+  if (!is_sum_known)
   {
-    throw std::underflow_error("Underflow of number");
+    if (sum > 0 && std::numeric_limits< int >::max() - sum < pair.first)
+    {
+      throw std::overflow_error("Overflow of number");
+    }
+    else if (sum < 0 && pair.first < 0 && std::numeric_limits< int >::min() - sum > pair.first)
+    {
+      throw std::underflow_error("Underflow of number");
+    }
+    sum += pair.first;
   }
-  sum += pair.first;
-  names += (' ' + pair.second);
-  return *this;
+  names += ' ';
+  names += pair.second;
 }
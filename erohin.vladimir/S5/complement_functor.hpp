@@ -9,9 +9,12 @@ namespace erohin
   {
     int sum;
     std::string names;
+    bool is_sum_known;
     ComplementFunctor();
+    explicit ComplementFunctor(size_t names_length);
+    ComplementFunctor(int known_sum, size_t names_length);
     ~ComplementFunctor();
-    ComplementFunctor operator()(const std::pair< int, std::string > & pair);
+    void operator()(const std::pair< int, std::string > & pair);
   };
 }
 
@@ -4,18 +4,17 @@
 #include <utility>
 #include <iterator>
 #include "tree_node.hpp"
-#include "queue.hpp"
-#include "stack.hpp"
+#include "breadth_level.hpp"
 
 namespace erohin
 {
-  template < class Key, class T, class Compare >
+  template < class Key, class T, class Compare, class Allocator, class Augment >
   class RedBlackTree;
 
   template< class Key, class T >
   class ConstBreadthIterator: public std::iterator< std::bidirectional_iterator_tag, T >
   {
-    template < class T1, class T2, class T3 >
+    template < class T1, class T2, class T3, class T4, class T5 >
     friend class RedBlackTree;
   public:
     ConstBreadthIterator();
@@ -32,51 +31,45 @@ namespace erohin
     bool operator!=(const ConstBreadthIterator< Key, T > & rhs) const;
   private:
     const detail::TreeNode< Key, T > * node_;
-    Queue< const detail::TreeNode< Key, T > * > queue_;
-    Stack< const detail::TreeNode< Key, T > * > stack_;
+    detail::breadth_level< const detail::TreeNode< Key, T > > level_;
+    size_t index_;
+    size_t depth_;
     explicit ConstBreadthIterator(const detail::TreeNode< Key, T > * node_ptr);
   };
 
   template< class Key, class T >
   ConstBreadthIterator< Key, T >::ConstBreadthIterator():
-    node_(nullptr)
+    node_(nullptr),
+    level_(),
+    index_(0),
+    depth_(0)
   {}
 
   template< class Key, class T >
   ConstBreadthIterator< Key, T >::ConstBreadthIterator(const detail::TreeNode< Key, T > * node_ptr):
-    node_(node_ptr)
-  {
-    queue_.push(node_ptr);
-  }
+    node_(node_ptr),
+    level_(node_ptr ? detail::makeRootLevel(node_ptr) : nullptr),
+    index_(0),
+    depth_(0)
+  {}
 
   template< class Key, class T >
   ConstBreadthIterator< Key, T > & ConstBreadthIterator< Key, T >::operator++()
   {
-    if (queue_.empty())
+    if (++index_ == level_->size())
+    {
+      level_ = detail::makeNextLevel(*level_);
+      index_ = 0;
+      ++depth_;
+    }
+    if (level_->empty())
     {
       node_ = nullptr;
+      level_.reset();
     }
     else
     {
-      node_ = queue_.front();
-      if (node_->left)
-      {
-        queue_.push(node_->left);
-      }
-      if (node_->right)
-      {
-        queue_.push(node_->right);
-      }
-      stack_.push(node_);
-      queue_.pop();
-      if (queue_.empty())
-      {
-        node_ = nullptr;
-      }
-      else
-      {
-        node_ = queue_.front();
-      }
+      node_ = (*level_)[index_];
     }
     return *this;
   }
@@ -92,16 +85,19 @@ namespace erohin
   template< class Key, class T >
   ConstBreadthIterator< Key, T > & ConstBreadthIterator< Key, T >::operator--()
   {
-    if (stack_.empty())
+    if (index_ == 0 && depth_ == 0)
     {
       node_ = nullptr;
+      level_.reset();
+      return *this;
     }
-    else
+    if (index_ == 0)
     {
-      node_ = stack_.top();
-      stack_.pop();
-      queue_.push(node_);
+      --depth_;
+      level_ = detail::makeLevel< const detail::TreeNode< Key, T > >(const_cast< detail::TreeNode< Key, T > * >(node_)->root(), depth_);
+      index_ = level_->size();
     }
+    node_ = (*level_)[--index_];
     return *this;
   }
 
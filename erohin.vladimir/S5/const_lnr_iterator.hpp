@@ -8,7 +8,7 @@
 
 namespace erohin
 {
-  template < class Key, class T, class Compare >
+  template < class Key, class T, class Compare, class Allocator, class Augment >
   class RedBlackTree;
 
   template < class Key, class T >
@@ -17,7 +17,7 @@ namespace erohin
   template< class Key, class T >
   class ConstLnrIterator: public std::iterator< std::bidirectional_iterator_tag, const std::pair< Key, T > >
   {
-    template < class T1, class T2, class T3 >
+    template < class T1, class T2, class T3, class T4, class T5 >
     friend class RedBlackTree;
 
     template < class T1, class T2 >
@@ -67,26 +67,18 @@ namespace erohin
     }
     else
     {
-      if (stack_.empty())
-      {
-        node_ = nullptr;
-        return *this;
-      }
-      while (stack_.top()->right == node_)
+      while (!stack_.empty() && stack_.top()->right == node_)
       {
         node_ = stack_.top();
         stack_.pop();
-        if (stack_.empty())
-        {
-          node_ = nullptr;
-          return *this;
-        }
       }
-      while (!stack_.empty() && stack_.top()->left == node_)
+      if (stack_.empty())
       {
-        node_ = stack_.top();
-        stack_.pop();
+        node_ = nullptr;
+        return *this;
       }
+      node_ = stack_.top();
+      stack_.pop();
     }
     return *this;
   }
@@ -114,26 +106,18 @@ namespace erohin
     }
     else
     {
-      if (stack_.empty())
-      {
-        node_ = nullptr;
-        return *this;
-      }
-      while (stack_.top()->left == node_)
+      while (!stack_.empty() && stack_.top()->left == node_)
       {
         node_ = stack_.top();
         stack_.pop();
-        if (stack_.empty())
-        {
-          node_ = nullptr;
-          return *this;
-        }
       }
-      while (!stack_.empty() && stack_.top()->right == node_)
+      if (stack_.empty())
       {
-        node_ = stack_.top();
-        stack_.pop();
+        node_ = nullptr;
+        return *this;
       }
+      node_ = stack_.top();
+      stack_.pop();
     }
     return *this;
   }
@@ -8,13 +8,13 @@
 
 namespace erohin
 {
-  template < class Key, class T, class Compare >
+  template < class Key, class T, class Compare, class Allocator, class Augment >
   class RedBlackTree;
 
   template< class Key, class T >
   class ConstRnlIterator: public std::iterator< std::bidirectional_iterator_tag, const std::pair< Key, T > >
   {
-    template < class T1, class T2, class T3 >
+    template < class T1, class T2, class T3, class T4, class T5 >
     friend class RedBlackTree;
   public:
     ConstRnlIterator() = default;
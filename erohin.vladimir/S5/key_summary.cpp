@@ -0,0 +1,55 @@
+#include "key_summary.hpp"
+#include <algorithm>
+#include <limits>
+
+erohin::KeySummary erohin::KeySummaryAugment::identity()
+{
+  return KeySummary{ 0, 0, 0, 0, 0, 0, 0 };
+}
+
+erohin::KeySummary erohin::KeySummaryAugment::make(const std::pair< int, std::string > & data)
+{
+  long long key = data.first;
+  return KeySummary{ key, key, key, key, key, 1, data.second.size() };
+}
+
+erohin::KeySummary erohin::KeySummaryAugment::combine(const KeySummary & lhs, const KeySummary & rhs)
+{
+  if (lhs.count == 0)
+  {
+    return rhs;
+  }
+  else if (rhs.count == 0)
+  {
+    return lhs;
+  }
+  KeySummary result;
+  result.sum = lhs.sum + rhs.sum;
+  result.min_prefix = std::min(lhs.min_prefix, lhs.sum + rhs.min_prefix);
+  result.max_prefix = std::max(lhs.max_prefix, lhs.sum + rhs.max_prefix);
+  result.min_suffix = std::min(rhs.min_suffix, rhs.sum + lhs.min_suffix);
+  result.max_suffix = std::max(rhs.max_suffix, rhs.sum + lhs.max_suffix);
+  result.count = lhs.count + rhs.count;
+  result.names_length = lhs.names_length + rhs.names_length;
+  return result;
+}
+
+namespace erohin
+{
+  bool isIntRange(long long min, long long max);
+}
+
+bool erohin::isAscendingSumValid(const KeySummary & summary)
+{
+  return isIntRange(summary.min_prefix, summary.max_prefix);
+}
+
+bool erohin::isDescendingSumValid(const KeySummary & summary)
+{
+  return isIntRange(summary.min_suffix, summary.max_suffix);
+}
+
+bool erohin::isIntRange(long long min, long long max)
+{
+  return (min >= std::numeric_limits< int >::min() && max <= std::numeric_limits< int >::max());
+}
@@ -0,0 +1,33 @@
+#ifndef KEY_SUMMARY_HPP
+#define KEY_SUMMARY_HPP
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace erohin
+{
+  struct KeySummary
+  {
+    long long sum;
+    long long min_prefix;
+    long long max_prefix;
+    long long min_suffix;
+    long long max_suffix;
+    size_t count;
+    size_t names_length;
+  };
+
+  struct KeySummaryAugment
+  {
+    using value_type = KeySummary;
+    static KeySummary identity();
+    static KeySummary make(const std::pair< int, std::string > & data);
+    static KeySummary combine(const KeySummary & lhs, const KeySummary & rhs);
+  };
+
+  bool isAscendingSumValid(const KeySummary & summary);
+  bool isDescendingSumValid(const KeySummary & summary);
+}
+
+#endif
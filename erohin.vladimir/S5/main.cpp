@@ -2,8 +2,10 @@
 #include <fstream>
 #include <functional>
 #include <stdexcept>
+#include <cstring>
 #include "red_black_tree.hpp"
 #include "complement_functor.hpp"
+#include "key_summary.hpp"
 
 int main(int argc, char ** argv)
 {
@@ -19,7 +21,7 @@ int main(int argc, char ** argv)
     std::cerr << "Error in file opening";
     return 2;
   }
-  using tree_t = RedBlackTree< int, std::string >;
+  using tree_t = RedBlackTree< int, std::string, std::less< int >, std::allocator< std::pair< int, std::string > >, KeySummaryAugment >;
   tree_t collection;
   int key = 0;
   std::string name;
@@ -49,8 +51,18 @@ int main(int argc, char ** argv)
   {
     try
     {
-      ComplementFunctor functor;
-      functor = traversal.at(argv[1])(functor);
+      KeySummary summary = collection.aggregate();
+      size_t names_length = summary.names_length + summary.count;
+      ComplementFunctor functor(names_length);
+      if (!std::strcmp(argv[1], "ascending") && isAscendingSumValid(summary))
+      {
+        functor = ComplementFunctor(static_cast< int >(summary.sum), names_length);
+      }
+      else if (!std::strcmp(argv[1], "descending") && isDescendingSumValid(summary))
+      {
+        functor = ComplementFunctor(static_cast< int >(summary.sum), names_length);
+      }
+      functor = traversal.at(argv[1])(std::move(functor));
       std::cout << functor.sum << functor.names << "\n";
     }
     catch (const std::exception & e)
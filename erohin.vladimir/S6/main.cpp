@@ -3,36 +3,52 @@
 #include <stdexcept>
 #include <functional>
 #include <cstdlib>
+#include <cstring>
 #include "red_black_tree.hpp"
 #include "sort_command.hpp"
+#include "sort_benchmark.hpp"
 
 int main(int argc, char ** argv)
 {
   std::srand(std::time(0));
   using namespace erohin;
-  if (argc != 4)
+  bool is_benchmark = (argc == 5 && !std::strcmp(argv[1], "--benchmark"));
+  if (argc != 4 && !is_benchmark)
   {
     std::cerr << "Wrong CLA's number\n";
     return 1;
   }
+  char ** args = is_benchmark ? argv + 1 : argv;
   try
   {
-    size_t size = std::stoull(argv[3]);
+    size_t size = std::stoull(args[3]);
     if (size == 0)
     {
       throw std::invalid_argument("Invalid sequence size");
     }
     using sort_func_cmd = std::function< void(std::ostream &) >;
     RedBlackTree< std::pair< std::string, std::string >, sort_func_cmd > sort_case;
+    RedBlackTree< std::pair< std::string, std::string >, sort_func_cmd > benchmark_case;
     {
       using namespace std::placeholders;
       sort_case[{ "ascending", "ints" }] = std::bind(doSortCommand< int, std::less< int > >, _1, size);
       sort_case[{ "descending", "ints" }] = std::bind(doSortCommand< int, std::greater< int > >, _1, size);
       sort_case[{ "ascending", "floats" }] = std::bind(doSortCommand< float, std::less< float > >, _1, size);
       sort_case[{ "descending", "floats" }] = std::bind(doSortCommand< float, std::greater< float > >, _1, size);
+      benchmark_case[{ "ascending", "ints" }] = std::bind(doBenchmarkCommand< int, std::less< int > >, _1, size, "ints");
+      benchmark_case[{ "descending", "ints" }] = std::bind(doBenchmarkCommand< int, std::greater< int > >, _1, size, "ints");
+      benchmark_case[{ "ascending", "floats" }] = std::bind(doBenchmarkCommand< float, std::less< float > >, _1, size, "floats");
+      benchmark_case[{ "descending", "floats" }] = std::bind(doBenchmarkCommand< float, std::greater< float > >, _1, size, "floats");
     }
     std::cout << std::setprecision(1) << std::fixed;
-    sort_case.at({ argv[1], argv[2] })(std::cout);
+    if (is_benchmark)
+    {
+      benchmark_case.at({ args[1], args[2] })(std::cout);
+    }
+    else
+    {
+      sort_case.at({ args[1], args[2] })(std::cout);
+    }
   }
   catch (const std::exception & e)
   {
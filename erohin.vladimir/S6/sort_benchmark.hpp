@@ -0,0 +1,280 @@
+#ifndef SORT_BENCHMARK_HPP
+#define SORT_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+#include "list.hpp"
+#include "sequence_operations.hpp"
+#include "sort_functions.hpp"
+
+namespace erohin
+{
+  struct SortStatistics
+  {
+    size_t comparisons;
+    size_t moves;
+  };
+
+  template< class T >
+  class CountedValue
+  {
+  public:
+    static SortStatistics statistics;
+    CountedValue(const T & value);
+    CountedValue(const CountedValue< T > & other);
+    CountedValue(CountedValue< T > && other);
+    ~CountedValue() = default;
+    CountedValue< T > & operator=(const CountedValue< T > & other);
+    CountedValue< T > & operator=(CountedValue< T > && other);
+    const T & get() const;
+  private:
+    T value_;
+  };
+
+  template< class T >
+  SortStatistics CountedValue< T >::statistics = { 0, 0 };
+
+  template< class T >
+  CountedValue< T >::CountedValue(const T & value):
+    value_(value)
+  {}
+
+  template< class T >
+  CountedValue< T >::CountedValue(const CountedValue< T > & other):
+    value_(other.value_)
+  {
+    ++statistics.moves;
+  }
+
+  template< class T >
+  CountedValue< T >::CountedValue(CountedValue< T > && other):
+    value_(std::move(other.value_))
+  {
+    ++statistics.moves;
+  }
+
+  template< class T >
+  CountedValue< T > & CountedValue< T >::operator=(const CountedValue< T > & other)
+  {
+    value_ = other.value_;
+    ++statistics.moves;
+    return *this;
+  }
+
+  template< class T >
+  CountedValue< T > & CountedValue< T >::operator=(CountedValue< T > && other)
+  {
+    value_ = std::move(other.value_);
+    ++statistics.moves;
+    return *this;
+  }
+
+  template< class T >
+  const T & CountedValue< T >::get() const
+  {
+    return value_;
+  }
+
+  template< class T, class Compare >
+  struct CountingCompare
+  {
+    bool operator()(const CountedValue< T > & lhs, const CountedValue< T > & rhs) const
+    {
+      ++CountedValue< T >::statistics.comparisons;
+      return Compare{}(lhs.get(), rhs.get());
+    }
+  };
+
+  struct QuicksortCase
+  {
+    template< class Container, class Compare >
+    void operator()(Container & container, Compare cmp) const
+    {
+      doQuicksort(container.begin(), container.end(), cmp);
+    }
+  };
+
+  struct TimsortCase
+  {
+    template< class Container, class Compare >
+    void operator()(Container & container, Compare cmp) const
+    {
+      doTimsort(container.begin(), container.size(), cmp);
+    }
+  };
+
+  struct ListSortCase
+  {
+    template< class Container, class Compare >
+    void operator()(Container & container, Compare cmp) const
+    {
+      container.sort(cmp);
+    }
+  };
+
+  struct StdSortCase
+  {
+    template< class Container, class Compare >
+    void operator()(Container & container, Compare cmp) const
+    {
+      std::sort(container.begin(), container.end(), cmp);
+    }
+  };
+
+  enum class Distribution
+  {
+    UNIFORM,
+    SORTED,
+    REVERSED,
+    FEW_UNIQUE,
+    ORGAN_PIPE,
+    NEARLY_SORTED
+  };
+
+  namespace detail
+  {
+    constexpr size_t min_benchmark_repeats = 5;
+    constexpr size_t max_benchmark_repeats = 51;
+    constexpr size_t stable_median_ratio = 50;
+
+    inline const char * getDistributionName(Distribution distribution)
+    {
+      const char * names[] = { "uniform", "sorted", "reversed", "few-unique", "organ-pipe", "nearly-sorted" };
+      return names[static_cast< size_t >(distribution)];
+    }
+
+    template< class T, class Compare >
+    std::vector< T > generateSequence(Distribution distribution, size_t size)
+    {
+      Compare cmp;
+      std::vector< T > seq(size, T());
+      if (distribution == Distribution::FEW_UNIQUE)
+      {
+        std::generate(seq.begin(), seq.end(), std::bind(getRandom< int >, 0, 10));
+        return seq;
+      }
+      std::generate(seq.begin(), seq.end(), std::bind(getRandom< T >, -1000000, 1000000));
+      if (distribution == Distribution::UNIFORM)
+      {
+        return seq;
+      }
+      std::sort(seq.begin(), seq.end(), cmp);
+      if (distribution == Distribution::REVERSED)
+      {
+        std::reverse(seq.begin(), seq.end());
+      }
+      else if (distribution == Distribution::ORGAN_PIPE)
+      {
+        std::reverse(seq.begin() + size / 2, seq.end());
+      }
+      else if (distribution == Distribution::NEARLY_SORTED)
+      {
+        for (size_t i = 0; i <= size / 100; ++i)
+        {
+          std::swap(seq[std::rand() % size], seq[std::rand() % size]);
+        }
+      }
+      return seq;
+    }
+
+    inline long long getMedian(std::vector< long long > samples)
+    {
+      auto middle = samples.begin() + samples.size() / 2;
+      std::nth_element(samples.begin(), middle, samples.end());
+      return *middle;
+    }
+
+    template< class Container, class T, class Compare, class Sorter >
+    long long measureSortTime(const std::vector< T > & seq, Sorter sorter)
+    {
+      Container container(seq.cbegin(), seq.cend());
+      auto start = std::chrono::steady_clock::now();
+      sorter(container, Compare{});
+      auto finish = std::chrono::steady_clock::now();
+      return std::chrono::duration_cast< std::chrono::nanoseconds >(finish - start).count();
+    }
+
+    template< class Container, class T, class Compare, class Sorter >
+    long long measureMedianTime(const std::vector< T > & seq, Sorter sorter)
+    {
+      std::vector< long long > samples;
+      long long prev_median = 0;
+      while (samples.size() < max_benchmark_repeats)
+      {
+        samples.push_back(measureSortTime< Container, T, Compare >(seq, sorter));
+        if (samples.size() >= min_benchmark_repeats)
+        {
+          long long median = getMedian(samples);
+          if (std::abs(median - prev_median) * static_cast< long long >(stable_median_ratio) <= median)
+          {
+            return median;
+          }
+          prev_median = median;
+        }
+      }
+      return getMedian(samples);
+    }
+
+    template< class Container, class T, class Compare, class Sorter >
+    SortStatistics countSortOperations(const std::vector< T > & seq, Sorter sorter)
+    {
+      Container container(seq.cbegin(), seq.cend());
+      CountedValue< T >::statistics = { 0, 0 };
+      sorter(container, CountingCompare< T, Compare >{});
+      return CountedValue< T >::statistics;
+    }
+  }
+
+  template< template< class... > class Container, class T, class Compare, class Sorter >
+  void doBenchmarkCase(std::ostream & output, const char * algorithm, const char * container,
+    const std::string & type, Distribution distribution, const std::vector< T > & seq, Sorter sorter)
+  {
+    long long median = detail::measureMedianTime< Container< T >, T, Compare >(seq, sorter);
+    SortStatistics stat = detail::countSortOperations< Container< CountedValue< T > >, T, Compare >(seq, sorter);
+    output << algorithm << "," << container << "," << type << "," << detail::getDistributionName(distribution);
+    output << "," << seq.size() << "," << median << "," << stat.comparisons << "," << stat.moves << std::endl;
+  }
+
+  template< class T, class Compare >
+  void doBenchmarkCommand(std::ostream & output, size_t max_size, const std::string & type)
+  {
+    const Distribution distributions[] = {
+      Distribution::UNIFORM,
+      Distribution::SORTED,
+      Distribution::REVERSED,
+      Distribution::FEW_UNIQUE,
+      Distribution::ORGAN_PIPE,
+      Distribution::NEARLY_SORTED
+    };
+    output << "algorithm,container,type,distribution,n,median_ns,comparisons,moves\n";
+    size_t size = std::min< size_t >(10, max_size);
+    while (true)
+    {
+      for (Distribution distribution: distributions)
+      {
+        std::vector< T > seq = detail::generateSequence< T, Compare >(distribution, size);
+        doBenchmarkCase< List, T, Compare >(output, "quicksort", "List", type, distribution, seq, QuicksortCase{});
+        doBenchmarkCase< std::list, T, Compare >(output, "quicksort", "std::list", type, distribution, seq, QuicksortCase{});
+        doBenchmarkCase< std::list, T, Compare >(output, "list::sort", "std::list", type, distribution, seq, ListSortCase{});
+        doBenchmarkCase< std::deque, T, Compare >(output, "quicksort", "std::deque", type, distribution, seq, QuicksortCase{});
+        doBenchmarkCase< std::deque, T, Compare >(output, "timsort", "std::deque", type, distribution, seq, TimsortCase{});
+        doBenchmarkCase< std::deque, T, Compare >(output, "std::sort", "std::deque", type, distribution, seq, StdSortCase{});
+      }
+      if (size == max_size)
+      {
+        break;
+      }
+      size = std::min(size * 10, max_size);
+    }
+  }
+}
+
+#endif
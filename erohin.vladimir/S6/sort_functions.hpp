@@ -3,123 +3,391 @@
 
 #include <algorithm>
 #include <iterator>
+#include <utility>
+#include <vector>
 
 namespace erohin
 {
   namespace detail
   {
+    constexpr size_t insertsort_threshold = 16;
+
     template< class ForwardIt, class Compare >
-    ForwardIt doPartition(ForwardIt begin, ForwardIt end, Compare cmp)
+    void doForwardInsertsort(ForwardIt begin, ForwardIt end, Compare cmp)
     {
-      auto pivot = begin;
+      if (begin == end)
+      {
+        return;
+      }
       auto cur_iter = std::next(begin);
       while (cur_iter != end)
       {
-        if (!cmp(*pivot, *cur_iter))
+        auto next_iter = std::next(cur_iter);
+        auto place = std::upper_bound(begin, cur_iter, *cur_iter, cmp);
+        if (place != cur_iter)
         {
-          auto temp_iter = pivot;
-          using T = typename ForwardIt::value_type;
-          T temp(std::move(*cur_iter));
-          while (temp_iter != std::next(cur_iter))
-          {
-            std::swap(*temp_iter, temp);
-            ++temp_iter;
-          }
-          ++pivot;
+          std::rotate(place, cur_iter, next_iter);
+        }
+        cur_iter = next_iter;
+      }
+    }
+
+    template< class ForwardIt, class Compare >
+    void doForwardHeapsort(ForwardIt begin, ForwardIt end, size_t size, Compare cmp)
+    {
+      using T = typename std::iterator_traits< ForwardIt >::value_type;
+      std::vector< T > buffer;
+      buffer.reserve(size);
+      std::move(begin, end, std::back_inserter(buffer));
+      std::make_heap(buffer.begin(), buffer.end(), cmp);
+      std::sort_heap(buffer.begin(), buffer.end(), cmp);
+      std::move(buffer.begin(), buffer.end(), begin);
+    }
+
+    template< class ForwardIt, class Compare >
+    ForwardIt selectPivot(ForwardIt begin, size_t size, Compare cmp)
+    {
+      auto middle = std::next(begin, size / 2);
+      auto last = std::next(middle, size - size / 2 - 1);
+      if (cmp(*middle, *begin))
+      {
+        std::swap(begin, middle);
+      }
+      if (cmp(*last, *middle))
+      {
+        middle = cmp(*last, *begin) ? begin : last;
+      }
+      return middle;
+    }
+
+    template< class ForwardIt, class Compare >
+    std::pair< ForwardIt, ForwardIt > doPartition(ForwardIt begin, ForwardIt end, ForwardIt pivot, Compare cmp)
+    {
+      using T = typename std::iterator_traits< ForwardIt >::value_type;
+      T pivot_value(*pivot);
+      auto less_end = begin;
+      auto equal_end = begin;
+      while (begin != end)
+      {
+        if (cmp(*begin, pivot_value))
+        {
+          std::iter_swap(begin, equal_end);
+          std::iter_swap(equal_end, less_end);
+          ++less_end;
+          ++equal_end;
+        }
+        else if (!cmp(pivot_value, *begin))
+        {
+          std::iter_swap(begin, equal_end);
+          ++equal_end;
+        }
+        ++begin;
+      }
+      return std::make_pair(less_end, equal_end);
+    }
+
+    template< class ForwardIt, class Compare >
+    void doIntrosort(ForwardIt begin, ForwardIt end, size_t size, size_t depth_limit, Compare cmp)
+    {
+      while (size > insertsort_threshold)
+      {
+        if (depth_limit == 0)
+        {
+          doForwardHeapsort(begin, end, size, cmp);
+          return;
+        }
+        --depth_limit;
+        auto bounds = doPartition(begin, end, selectPivot(begin, size, cmp), cmp);
+        size_t less_size = std::distance(begin, bounds.first);
+        size_t greater_size = size - less_size - std::distance(bounds.first, bounds.second);
+        if (less_size < greater_size)
+        {
+          doIntrosort(begin, bounds.first, less_size, depth_limit, cmp);
+          begin = bounds.second;
+          size = greater_size;
+        }
+        else
+        {
+          doIntrosort(bounds.second, end, greater_size, depth_limit, cmp);
+          end = bounds.first;
+          size = less_size;
         }
-        ++cur_iter;
       }
-      return pivot;
+      doForwardInsertsort(begin, end, cmp);
     }
   }
 
   template< class ForwardIt, class Compare >
   void doQuicksort(ForwardIt begin, ForwardIt end, Compare cmp)
   {
-    if (begin != end)
+    size_t size = std::distance(begin, end);
+    size_t depth_limit = 0;
+    for (size_t n = size; n > 1; n >>= 1)
     {
-      auto pivot = detail::doPartition(begin, end, cmp);
-      doQuicksort(begin, pivot, cmp);
-      doQuicksort(std::next(pivot), end, cmp);
+      depth_limit += 2;
     }
+    detail::doIntrosort(begin, end, size, depth_limit, cmp);
   }
 
   namespace detail
   {
+    constexpr size_t min_gallop_threshold = 7;
+
+    struct TimsortRun
+    {
+      size_t base;
+      size_t length;
+    };
+
     template< class RandomAccessIt, class Compare >
-    void doInsertsort(RandomAccessIt begin, size_t size, Compare cmp)
+    size_t countRun(RandomAccessIt begin, size_t size, Compare cmp)
     {
+      size_t length = 1;
       if (size <= 1)
       {
-        return;
+        return size;
       }
-      size_t i = 1;
-      auto cur_iter = std::next(begin);
-      while (i < size)
+      if (cmp(begin[1], begin[0]))
       {
-        auto temp_iter = cur_iter;
-        auto start = std::prev(cur_iter);
-        while (temp_iter != begin)
+        while (length < size && cmp(begin[length], begin[length - 1]))
         {
-          if (cmp(*temp_iter, *start))
+          ++length;
+        }
+        std::reverse(begin, begin + length);
+      }
+      else
+      {
+        while (length < size && !cmp(begin[length], begin[length - 1]))
+        {
+          ++length;
+        }
+      }
+      return length;
+    }
+
+    template< class RandomAccessIt, class Compare >
+    void doBinaryInsertsort(RandomAccessIt begin, size_t sorted_size, size_t size, Compare cmp)
+    {
+      for (size_t i = sorted_size; i < size; ++i)
+      {
+        auto place = std::upper_bound(begin, begin + i, begin[i], cmp);
+        if (place != begin + i)
+        {
+          auto value = std::move(begin[i]);
+          std::move_backward(place, begin + i, begin + i + 1);
+          *place = std::move(value);
+        }
+      }
+    }
+
+    template< class RandomAccessIt, class T, class Compare >
+    size_t gallopLeft(const T & key, RandomAccessIt base, size_t size, size_t hint, Compare cmp)
+    {
+      size_t last_offset = 0;
+      size_t offset = 1;
+      size_t low = 0;
+      size_t high = 0;
+      if (cmp(base[hint], key))
+      {
+        size_t max_offset = size - hint;
+        while (offset < max_offset && cmp(base[hint + offset], key))
+        {
+          last_offset = offset;
+          offset = offset * 2 + 1;
+        }
+        offset = std::min(offset, max_offset);
+        low = hint + last_offset + 1;
+        high = hint + offset;
+      }
+      else
+      {
+        size_t max_offset = hint + 1;
+        while (offset < max_offset && !cmp(base[hint - offset], key))
+        {
+          last_offset = offset;
+          offset = offset * 2 + 1;
+        }
+        offset = std::min(offset, max_offset);
+        low = hint + 1 - offset;
+        high = hint - last_offset;
+      }
+      return std::lower_bound(base + low, base + high, key, cmp) - base;
+    }
+
+    template< class RandomAccessIt, class T, class Compare >
+    size_t gallopRight(const T & key, RandomAccessIt base, size_t size, size_t hint, Compare cmp)
+    {
+      size_t last_offset = 0;
+      size_t offset = 1;
+      size_t low = 0;
+      size_t high = 0;
+      if (cmp(key, base[hint]))
+      {
+        size_t max_offset = hint + 1;
+        while (offset < max_offset && cmp(key, base[hint - offset]))
+        {
+          last_offset = offset;
+          offset = offset * 2 + 1;
+        }
+        offset = std::min(offset, max_offset);
+        low = hint + 1 - offset;
+        high = hint - last_offset;
+      }
+      else
+      {
+        size_t max_offset = size - hint;
+        while (offset < max_offset && !cmp(key, base[hint + offset]))
+        {
+          last_offset = offset;
+          offset = offset * 2 + 1;
+        }
+        offset = std::min(offset, max_offset);
+        low = hint + last_offset + 1;
+        high = hint + offset;
+      }
+      return std::upper_bound(base + low, base + high, key, cmp) - base;
+    }
+
+    template< class RandomAccessIt, class Buffer, class Compare >
+    void doMergeLow(RandomAccessIt first, size_t first_size, RandomAccessIt second, size_t second_size,
+      Buffer & buffer, size_t & min_gallop, Compare cmp)
+    {
+      buffer.clear();
+      std::move(first, first + first_size, std::back_inserter(buffer));
+      auto temp_iter = buffer.begin();
+      auto dest = first;
+      while (first_size > 0 && second_size > 0)
+      {
+        size_t first_count = 0;
+        size_t second_count = 0;
+        while (first_size > 0 && second_size > 0)
+        {
+          if (cmp(*second, *temp_iter))
           {
-            std::iter_swap(temp_iter, start);
-            --temp_iter;
+            *(dest++) = std::move(*(second++));
+            --second_size;
+            first_count = 0;
+            if (++second_count >= min_gallop)
+            {
+              break;
+            }
           }
           else
+          {
+            *(dest++) = std::move(*(temp_iter++));
+            --first_size;
+            second_count = 0;
+            if (++first_count >= min_gallop)
+            {
+              break;
+            }
+          }
+        }
+        while (first_size > 0 && second_size > 0)
+        {
+          first_count = gallopRight(*second, temp_iter, first_size, 0, cmp);
+          dest = std::move(temp_iter, temp_iter + first_count, dest);
+          temp_iter += first_count;
+          first_size -= first_count;
+          if (first_size == 0)
           {
             break;
           }
-          start--;
+          second_count = gallopLeft(*temp_iter, second, second_size, 0, cmp);
+          dest = std::move(second, second + second_count, dest);
+          second += second_count;
+          second_size -= second_count;
+          if (first_count < min_gallop_threshold && second_count < min_gallop_threshold)
+          {
+            ++min_gallop;
+            break;
+          }
+          if (min_gallop > 1)
+          {
+            --min_gallop;
+          }
         }
-        ++cur_iter;
-        ++i;
       }
+      std::move(temp_iter, temp_iter + first_size, dest);
     }
 
-    template< class RandomAccessIt, class Compare >
-    void doMergesort(RandomAccessIt begin, size_t size, Compare cmp)
+    template< class RandomAccessIt, class Buffer, class Compare >
+    void doMergeAt(RandomAccessIt begin, std::vector< TimsortRun > & runs, size_t index,
+      Buffer & buffer, size_t & min_gallop, Compare cmp)
     {
-      if (size <= 1)
+      size_t first_base = runs[index].base;
+      size_t first_size = runs[index].length;
+      size_t second_base = runs[index + 1].base;
+      size_t second_size = runs[index + 1].length;
+      runs[index].length += second_size;
+      runs.erase(runs.begin() + index + 1);
+      size_t skipped = gallopRight(begin[second_base], begin + first_base, first_size, 0, cmp);
+      first_base += skipped;
+      first_size -= skipped;
+      if (first_size == 0)
       {
         return;
       }
-      size_t left_size = size / 2;
-      size_t right_size = size - size / 2;
-      doMergesort(begin, left_size, cmp);
-      doMergesort(begin + left_size, right_size, cmp);
-      size_t l_size = left_size;
-      size_t r_size = right_size;
-      using T = typename RandomAccessIt::value_type;
-      T * temp_arr = new T[size]{ *begin };
-      try
+      second_size = gallopLeft(begin[first_base + first_size - 1], begin + second_base, second_size, second_size - 1, cmp);
+      if (second_size == 0)
       {
-        while ((l_size > 0) || (r_size > 0))
+        return;
+      }
+      if (first_size <= second_size)
+      {
+        doMergeLow(begin + first_base, first_size, begin + second_base, second_size, buffer, min_gallop, cmp);
+      }
+      else
+      {
+        using value_type = typename std::iterator_traits< RandomAccessIt >::value_type;
+        auto reverse_cmp = [cmp](const value_type & lhs, const value_type & rhs)
         {
-          size_t cur_index = size - l_size - r_size;
-          if (r_size == 0 || (l_size > 0 && cmp(begin[left_size - l_size], begin[left_size + right_size - r_size])))
-          {
-            temp_arr[cur_index] = std::move(begin[left_size - l_size]);
-            --l_size;
-          }
-          else
+          return cmp(rhs, lhs);
+        };
+        using reverse_iterator = std::reverse_iterator< RandomAccessIt >;
+        reverse_iterator second_rbegin(begin + second_base + second_size);
+        reverse_iterator first_rbegin(begin + first_base + first_size);
+        doMergeLow(second_rbegin, second_size, first_rbegin, first_size, buffer, min_gallop, reverse_cmp);
+      }
+    }
+
+    template< class RandomAccessIt, class Buffer, class Compare >
+    void doMergeCollapse(RandomAccessIt begin, std::vector< TimsortRun > & runs,
+      Buffer & buffer, size_t & min_gallop, Compare cmp)
+    {
+      while (runs.size() > 1)
+      {
+        size_t n = runs.size() - 2;
+        bool is_first_broken = (n > 0 && runs[n - 1].length <= runs[n].length + runs[n + 1].length);
+        bool is_second_broken = (n > 1 && runs[n - 2].length <= runs[n - 1].length + runs[n].length);
+        if (is_first_broken || is_second_broken)
+        {
+          if (runs[n - 1].length < runs[n + 1].length)
           {
-            temp_arr[cur_index] = std::move(begin[left_size + right_size - r_size]);
-            --r_size;
+            --n;
           }
         }
-        for (size_t i = 0; i < size; ++i)
+        else if (runs[n].length > runs[n + 1].length)
         {
-          begin[i] = std::move(temp_arr[i]);
+          return;
         }
-        delete[] temp_arr;
+        doMergeAt(begin, runs, n, buffer, min_gallop, cmp);
       }
-      catch (...)
+    }
+
+    template< class RandomAccessIt, class Buffer, class Compare >
+    void doMergeForceCollapse(RandomAccessIt begin, std::vector< TimsortRun > & runs,
+      Buffer & buffer, size_t & min_gallop, Compare cmp)
+    {
+      while (runs.size() > 1)
       {
-        delete[] temp_arr;
-        throw;
+        size_t n = runs.size() - 2;
+        if (n > 0 && runs[n - 1].length < runs[n + 1].length)
+        {
+          --n;
+        }
+        doMergeAt(begin, runs, n, buffer, min_gallop, cmp);
       }
-
     }
   }
 
@@ -138,19 +406,27 @@ namespace erohin
       n = n >> 1;
     }
     min_run = n + min_run;
-    for (size_t i = 0; i < size; i += min_run)
-    {
-      detail::doInsertsort(begin + i, min_run, cmp);
-    }
-    size_t run = min_run;
-    while (run < size)
+    using T = typename std::iterator_traits< RandomAccessIt >::value_type;
+    std::vector< T > buffer;
+    buffer.reserve(size / 2);
+    std::vector< detail::TimsortRun > runs;
+    size_t min_gallop = detail::min_gallop_threshold;
+    size_t base = 0;
+    while (base < size)
     {
-      for (size_t i = 0; i < size; i += (run * 2))
+      size_t remaining = size - base;
+      size_t run = detail::countRun(begin + base, remaining, cmp);
+      if (run < min_run)
       {
-        detail::doMergesort(begin + i, run * 2, cmp);
+        size_t forced_run = std::min(min_run, remaining);
+        detail::doBinaryInsertsort(begin + base, run, forced_run, cmp);
+        run = forced_run;
       }
-      run *= 2;
+      runs.push_back({ base, run });
+      detail::doMergeCollapse(begin, runs, buffer, min_gallop, cmp);
+      base += run;
     }
+    detail::doMergeForceCollapse(begin, runs, buffer, min_gallop, cmp);
   }
 }
 
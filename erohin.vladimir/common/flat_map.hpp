@@ -0,0 +1,186 @@
+#ifndef FLAT_MAP_HPP
+#define FLAT_MAP_HPP
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include "dynamic_array.hpp"
+#include "flat_map_const_iterator.hpp"
+#include "red_black_tree.hpp"
+
+namespace erohin
+{
+  template< class Key, class T, class Compare = std::less< Key > >
+  class FlatMap
+  {
+  public:
+    using const_iterator = FlatMapConstIterator< Key, T >;
+    using iterator = const_iterator;
+    FlatMap();
+    template< class Allocator, class Augment >
+    explicit FlatMap(const RedBlackTree< Key, T, Compare, Allocator, Augment > & tree);
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+    template< class Allocator, class Augment >
+    void freeze(const RedBlackTree< Key, T, Compare, Allocator, Augment > & tree);
+    void assign_sorted(DynamicArray< std::pair< Key, T > > && records);
+    void clear();
+    void swap(FlatMap & rhs) noexcept;
+    size_t count(const Key & key) const;
+    const_iterator find(const Key & key) const;
+    const T & at(const Key & key) const;
+    const_iterator lower_bound(const Key & key) const;
+  private:
+    DynamicArray< std::pair< Key, T > > records_;
+    Compare cmp_;
+    size_t find_lower_index(const Key & key) const;
+    const_iterator make_iterator(size_t index) const;
+  };
+
+  template< class Key, class T, class Compare >
+  FlatMap< Key, T, Compare >::FlatMap():
+    records_(),
+    cmp_()
+  {}
+
+  template< class Key, class T, class Compare >
+  template< class Allocator, class Augment >
+  FlatMap< Key, T, Compare >::FlatMap(const RedBlackTree< Key, T, Compare, Allocator, Augment > & tree):
+    FlatMap()
+  {
+    freeze(tree);
+  }
+
+  template< class Key, class T, class Compare >
+  FlatMapConstIterator< Key, T > FlatMap< Key, T, Compare >::begin() const
+  {
+    return cbegin();
+  }
+
+  template< class Key, class T, class Compare >
+  FlatMapConstIterator< Key, T > FlatMap< Key, T, Compare >::end() const
+  {
+    return cend();
+  }
+
+  template< class Key, class T, class Compare >
+  FlatMapConstIterator< Key, T > FlatMap< Key, T, Compare >::cbegin() const
+  {
+    return make_iterator(0);
+  }
+
+  template< class Key, class T, class Compare >
+  FlatMapConstIterator< Key, T > FlatMap< Key, T, Compare >::cend() const
+  {
+    return make_iterator(size());
+  }
+
+  template< class Key, class T, class Compare >
+  bool FlatMap< Key, T, Compare >::empty() const noexcept
+  {
+    return records_.empty();
+  }
+
+  template< class Key, class T, class Compare >
+  size_t FlatMap< Key, T, Compare >::size() const noexcept
+  {
+    return records_.size();
+  }
+
+  template< class Key, class T, class Compare >
+  template< class Allocator, class Augment >
+  void FlatMap< Key, T, Compare >::freeze(const RedBlackTree< Key, T, Compare, Allocator, Augment > & tree)
+  {
+    DynamicArray< std::pair< Key, T > > records(tree.cbegin(), tree.cend());
+    records_.swap(records);
+  }
+
+  template< class Key, class T, class Compare >
+  void FlatMap< Key, T, Compare >::assign_sorted(DynamicArray< std::pair< Key, T > > && records)
+  {
+    DynamicArray< std::pair< Key, T > > temp(std::move(records));
+    records_.swap(temp);
+  }
+
+  template< class Key, class T, class Compare >
+  void FlatMap< Key, T, Compare >::clear()
+  {
+    FlatMap< Key, T, Compare > temp;
+    swap(temp);
+  }
+
+  template< class Key, class T, class Compare >
+  void FlatMap< Key, T, Compare >::swap(FlatMap & rhs) noexcept
+  {
+    records_.swap(rhs.records_);
+    std::swap(cmp_, rhs.cmp_);
+  }
+
+  template< class Key, class T, class Compare >
+  size_t FlatMap< Key, T, Compare >::count(const Key & key) const
+  {
+    return (find(key) != cend()) ? 1 : 0;
+  }
+
+  template< class Key, class T, class Compare >
+  FlatMapConstIterator< Key, T > FlatMap< Key, T, Compare >::find(const Key & key) const
+  {
+    size_t index = find_lower_index(key);
+    if (index == size() || cmp_(key, records_[index].first))
+    {
+      return cend();
+    }
+    return make_iterator(index);
+  }
+
+  template< class Key, class T, class Compare >
+  const T & FlatMap< Key, T, Compare >::at(const Key & key) const
+  {
+    size_t index = find_lower_index(key);
+    if (index == size() || cmp_(key, records_[index].first))
+    {
+      throw std::out_of_range("Out of range in element access");
+    }
+    return records_[index].second;
+  }
+
+  template< class Key, class T, class Compare >
+  FlatMapConstIterator< Key, T > FlatMap< Key, T, Compare >::lower_bound(const Key & key) const
+  {
+    return make_iterator(find_lower_index(key));
+  }
+
+  template< class Key, class T, class Compare >
+  size_t FlatMap< Key, T, Compare >::find_lower_index(const Key & key) const
+  {
+    size_t length = size();
+    if (length == 0)
+    {
+      return 0;
+    }
+    size_t base = 0;
+    while (length > 1)
+    {
+      size_t half = length / 2;
+      base += cmp_(records_[base + half - 1].first, key) ? half : 0;
+      length -= half;
+    }
+    return base + (cmp_(records_[base].first, key) ? 1 : 0);
+  }
+
+  template< class Key, class T, class Compare >
+  FlatMapConstIterator< Key, T > FlatMap< Key, T, Compare >::make_iterator(size_t index) const
+  {
+    if (empty())
+    {
+      return const_iterator();
+    }
+    return const_iterator(std::addressof(records_[0]) + index);
+  }
+}
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef FLAT_MAP_CONST_ITERATOR_HPP
+#define FLAT_MAP_CONST_ITERATOR_HPP
+
+#include <utility>
+#include <iterator>
+
+namespace erohin
+{
+  template< class Key, class T, class Compare >
+  class FlatMap;
+
+  template< class Key, class T >
+  class FlatMapConstIterator: public std::iterator< std::bidirectional_iterator_tag, const std::pair< Key, T > >
+  {
+    template < class T1, class T2, class T3 >
+    friend class FlatMap;
+  public:
+    FlatMapConstIterator();
+    FlatMapConstIterator(const FlatMapConstIterator< Key, T > &) = default;
+    ~FlatMapConstIterator() = default;
+    FlatMapConstIterator< Key, T > & operator=(const FlatMapConstIterator< Key, T > &) = default;
+    FlatMapConstIterator< Key, T > & operator++();
+    FlatMapConstIterator< Key, T > operator++(int);
+    FlatMapConstIterator< Key, T > & operator--();
+    FlatMapConstIterator< Key, T > operator--(int);
+    const std::pair< Key, T > & operator*() const;
+    const std::pair< Key, T > * operator->() const;
+    bool operator==(const FlatMapConstIterator< Key, T > & rhs) const;
+    bool operator!=(const FlatMapConstIterator< Key, T > & rhs) const;
+  private:
+    const std::pair< Key, T > * record_;
+    explicit FlatMapConstIterator(const std::pair< Key, T > * record_ptr);
+  };
+
+  template< class Key, class T >
+  FlatMapConstIterator< Key, T >::FlatMapConstIterator():
+    record_(nullptr)
+  {}
+
+  template< class Key, class T >
+  FlatMapConstIterator< Key, T >::FlatMapConstIterator(const std::pair< Key, T > * record_ptr):
+    record_(record_ptr)
+  {}
+
+  template< class Key, class T >
+  FlatMapConstIterator< Key, T > & FlatMapConstIterator< Key, T >::operator++()
+  {
+    ++record_;
+    return *this;
+  }
+
+  template< class Key, class T >
+  FlatMapConstIterator< Key, T > FlatMapConstIterator< Key, T >::operator++(int)
+  {
+    FlatMapConstIterator< Key, T > temp = *this;
+    operator++();
+    return temp;
+  }
+
+  template< class Key, class T >
+  FlatMapConstIterator< Key, T > & FlatMapConstIterator< Key, T >::operator--()
+  {
+    --record_;
+    return *this;
+  }
+
+  template< class Key, class T >
+  FlatMapConstIterator< Key, T > FlatMapConstIterator< Key, T >::operator--(int)
+  {
+    FlatMapConstIterator< Key, T > temp = *this;
+    operator--();
+    return temp;
+  }
+
+  template< class Key, class T >
+  const std::pair< Key, T > & FlatMapConstIterator< Key, T >::operator*() const
+  {
+    return *record_;
+  }
+
+  template< class Key, class T >
+  const std::pair< Key, T > * FlatMapConstIterator< Key, T >::operator->() const
+  {
+    return record_;
+  }
+
+  template< class Key, class T >
+  bool FlatMapConstIterator< Key, T >::operator==(const FlatMapConstIterator< Key, T > & rhs) const
+  {
+    return (record_ == rhs.record_);
+  }
+
+  template< class Key, class T >
+  bool FlatMapConstIterator< Key, T >::operator!=(const FlatMapConstIterator< Key, T > & rhs) const
+  {
+    return !(*this == rhs);
+  }
+}
+
+#endif
@@ -1,7 +1,9 @@
 #ifndef LIST_HPP
 #define LIST_HPP
 
+#include <functional>
 #include <initializer_list>
+#include <memory>
 #include <stdexcept>
 #include "node.hpp"
 #include "list_iterator.hpp"
@@ -58,11 +60,19 @@ namespace erohin
     void splice_after(const_iterator pos, List< T > & other, const_iterator first, const_iterator last);
     void splice_after(const_iterator pos, List< T > && other, const_iterator first, const_iterator last) noexcept;
     void reverse() noexcept;
+    void merge(List< T > & other);
+    void merge(List< T > && other);
+    template< class Compare >
+    void merge(List< T > & other, Compare cmp);
+    template< class Compare >
+    void merge(List< T > && other, Compare cmp);
     template< class Compare >
     void sort(Compare cmp);
     void sort();
   private:
     detail::Node< T > * head_;
+    template< class Compare >
+    static detail::Node< T > * merge_nodes(detail::Node< T > * first, detail::Node< T > * second, Compare cmp);
   };
 
   template< class T >
@@ -445,29 +455,72 @@ namespace erohin
     erase_after(iter_begin, iter_end);
   }
 
+  template< class T >
+  void List< T >::merge(List< T > & other)
+  {
+    merge(std::move(other), std::less< T >{});
+  }
+
+  template< class T >
+  void List< T >::merge(List< T > && other)
+  {
+    merge(std::move(other), std::less< T >{});
+  }
+
   template< class T >
   template< class Compare >
-  void List< T >::sort(Compare cmp)
+  void List< T >::merge(List< T > & other, Compare cmp)
   {
-    if (empty())
+    merge(std::move(other), cmp);
+  }
+
+  template< class T >
+  template< class Compare >
+  void List< T >::merge(List< T > && other, Compare cmp)
+  {
+    if (this == std::addressof(other))
     {
       return;
     }
-    bool is_sorted = false;
-    while (!is_sorted)
+    head_ = merge_nodes(head_, other.head_, cmp);
+    other.head_ = nullptr;
+  }
+
+  template< class T >
+  template< class Compare >
+  void List< T >::sort(Compare cmp)
+  {
+    const size_t max_bin_count = sizeof(size_t) * 8;
+    detail::Node< T > * bins[max_bin_count] = {};
+    size_t bin_count = 0;
+    while (head_)
     {
-      is_sorted = true;
-      auto iter = begin();
-      while (std::next(iter) != end())
+      detail::Node< T > * carry = head_;
+      head_ = head_->next_;
+      carry->next_ = nullptr;
+      size_t i = 0;
+      while (i < bin_count && bins[i])
       {
-        if (!cmp(*iter, *std::next(iter)))
-        {
-          std::swap(*iter, *std::next(iter));
-          is_sorted = false;
-        }
-        ++iter;
+        carry = merge_nodes(bins[i], carry, cmp);
+        bins[i] = nullptr;
+        ++i;
+      }
+      if (i == max_bin_count)
+      {
+        --i;
+      }
+      bins[i] = carry;
+      if (i == bin_count)
+      {
+        ++bin_count;
       }
     }
+    detail::Node< T > * result = nullptr;
+    for (size_t i = 0; i < bin_count; ++i)
+    {
+      result = merge_nodes(bins[i], result, cmp);
+    }
+    head_ = result;
   }
 
   template< class T >
@@ -476,6 +529,30 @@ namespace erohin
     sort(std::less< T >{});
   }
 
+  template< class T >
+  template< class Compare >
+  detail::Node< T > * List< T >::merge_nodes(detail::Node< T > * first, detail::Node< T > * second, Compare cmp)
+  {
+    detail::Node< T > * result = nullptr;
+    detail::Node< T > ** tail = std::addressof(result);
+    while (first && second)
+    {
+      if (cmp(second->data_, first->data_))
+      {
+        *tail = second;
+        second = second->next_;
+      }
+      else
+      {
+        *tail = first;
+        first = first->next_;
+      }
+      tail = std::addressof((*tail)->next_);
+    }
+    *tail = first ? first : second;
+    return result;
+  }
+
   namespace detail
   {
     template< class T >
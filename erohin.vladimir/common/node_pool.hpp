@@ -0,0 +1,206 @@
+#ifndef NODE_POOL_HPP
+#define NODE_POOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace erohin
+{
+  namespace detail
+  {
+    template< class Node, class Allocator >
+    class NodePool
+    {
+    public:
+      NodePool();
+      explicit NodePool(const Allocator & alloc);
+      NodePool(const NodePool &) = delete;
+      NodePool(NodePool && other) noexcept;
+      ~NodePool();
+      NodePool & operator=(const NodePool &) = delete;
+      NodePool & operator=(NodePool && other) noexcept;
+      template< class... Args >
+      Node * create(Args &&... args);
+      void destroy(Node * node) noexcept;
+      void release() noexcept;
+      void swap(NodePool & other) noexcept;
+      Allocator get_allocator() const;
+    private:
+      union Slot
+      {
+        Slot * next;
+        alignas(Node) char storage[sizeof(Node)];
+      };
+      struct Block
+      {
+        Block * prev;
+        Slot * slots;
+        size_t capacity;
+      };
+      using slot_allocator = typename std::allocator_traits< Allocator >::template rebind_alloc< Slot >;
+      using block_allocator = typename std::allocator_traits< Allocator >::template rebind_alloc< Block >;
+      using slot_traits = std::allocator_traits< slot_allocator >;
+      using block_traits = std::allocator_traits< block_allocator >;
+      static constexpr size_t min_block_capacity = 16;
+      static constexpr size_t max_block_capacity = 4096;
+      Allocator alloc_;
+      Block * last_block_;
+      Slot * free_list_;
+      Slot * next_slot_;
+      Slot * end_slot_;
+      Slot * allocate_slot();
+      void add_block();
+    };
+
+    template< class Node, class Allocator >
+    NodePool< Node, Allocator >::NodePool():
+      NodePool(Allocator())
+    {}
+
+    template< class Node, class Allocator >
+    NodePool< Node, Allocator >::NodePool(const Allocator & alloc):
+      alloc_(alloc),
+      last_block_(nullptr),
+      free_list_(nullptr),
+      next_slot_(nullptr),
+      end_slot_(nullptr)
+    {}
+
+    template< class Node, class Allocator >
+    NodePool< Node, Allocator >::NodePool(NodePool && other) noexcept:
+      alloc_(std::move(other.alloc_)),
+      last_block_(other.last_block_),
+      free_list_(other.free_list_),
+      next_slot_(other.next_slot_),
+      end_slot_(other.end_slot_)
+    {
+      other.last_block_ = nullptr;
+      other.free_list_ = nullptr;
+      other.next_slot_ = nullptr;
+      other.end_slot_ = nullptr;
+    }
+
+    template< class Node, class Allocator >
+    NodePool< Node, Allocator >::~NodePool()
+    {
+      release();
+    }
+
+    template< class Node, class Allocator >
+    NodePool< Node, Allocator > & NodePool< Node, Allocator >::operator=(NodePool && other) noexcept
+    {
+      if (this != std::addressof(other))
+      {
+        NodePool< Node, Allocator > temp(std::move(other));
+        swap(temp);
+      }
+      return *this;
+    }
+
+    template< class Node, class Allocator >
+    template< class... Args >
+    Node * NodePool< Node, Allocator >::create(Args &&... args)
+    {
+      Slot * slot = allocate_slot();
+      try
+      {
+        return ::new (static_cast< void * >(slot->storage)) Node(std::forward< Args >(args)...);
+      }
+      catch (...)
+      {
+        slot->next = free_list_;
+        free_list_ = slot;
+        throw;
+      }
+    }
+
+    template< class Node, class Allocator >
+    void NodePool< Node, Allocator >::destroy(Node * node) noexcept
+    {
+      node->~Node();
+      Slot * slot = reinterpret_cast< Slot * >(node);
+      slot->next = free_list_;
+      free_list_ = slot;
+    }
+
+    template< class Node, class Allocator >
+    void NodePool< Node, Allocator >::release() noexcept
+    {
+      slot_allocator slot_alloc(alloc_);
+      block_allocator block_alloc(alloc_);
+      while (last_block_)
+      {
+        Block * prev = last_block_->prev;
+        slot_traits::deallocate(slot_alloc, last_block_->slots, last_block_->capacity);
+        block_traits::deallocate(block_alloc, last_block_, 1);
+        last_block_ = prev;
+      }
+      free_list_ = nullptr;
+      next_slot_ = nullptr;
+      end_slot_ = nullptr;
+    }
+
+    template< class Node, class Allocator >
+    void NodePool< Node, Allocator >::swap(NodePool & other) noexcept
+    {
+      std::swap(alloc_, other.alloc_);
+      std::swap(last_block_, other.last_block_);
+      std::swap(free_list_, other.free_list_);
+      std::swap(next_slot_, other.next_slot_);
+      std::swap(end_slot_, other.end_slot_);
+    }
+
+    template< class Node, class Allocator >
+    Allocator NodePool< Node, Allocator >::get_allocator() const
+    {
+      return alloc_;
+    }
+
+    template< class Node, class Allocator >
+    typename NodePool< Node, Allocator >::Slot * NodePool< Node, Allocator >::allocate_slot()
+    {
+      if (free_list_)
+      {
+        Slot * slot = free_list_;
+        free_list_ = slot->next;
+        return slot;
+      }
+      if (next_slot_ == end_slot_)
+      {
+        add_block();
+      }
+      return next_slot_++;
+    }
+
+    template< class Node, class Allocator >
+    void NodePool< Node, Allocator >::add_block()
+    {
+      size_t capacity = last_block_ ? last_block_->capacity * 2 : min_block_capacity;
+      if (capacity > max_block_capacity)
+      {
+        capacity = max_block_capacity;
+      }
+      slot_allocator slot_alloc(alloc_);
+      block_allocator block_alloc(alloc_);
+      Block * block = block_traits::allocate(block_alloc, 1);
+      try
+      {
+        block->slots = slot_traits::allocate(slot_alloc, capacity);
+      }
+      catch (...)
+      {
+        block_traits::deallocate(block_alloc, block, 1);
+        throw;
+      }
+      block->capacity = capacity;
+      block->prev = last_block_;
+      last_block_ = block;
+      next_slot_ = block->slots;
+      end_slot_ = block->slots + capacity;
+    }
+  }
+}
+
+#endif
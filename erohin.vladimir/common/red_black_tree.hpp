@@ -3,7 +3,11 @@
 
 #include <functional>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
 #include "tree_node.hpp"
+#include "node_pool.hpp"
 #include "tree_const_iterator.hpp"
 #include "tree_iterator.hpp"
 
@@ -11,7 +15,8 @@
 
 namespace erohin
 {
-  template< class Key, class T, class Compare = std::less< Key > >
+  template< class Key, class T, class Compare = std::less< Key >, class Allocator = std::allocator< std::pair< Key, T > >,
+    class Augment = detail::NoAugment >
   class RedBlackTree
   {
   public:
@@ -26,15 +31,17 @@ namespace erohin
     using breadth_iterator = BreadthIterator< Key, T >;
     using const_breadth_iterator = ConstBreadthIterator< Key, T >;
     using value_type = std::pair< Key, T >;
+    using allocator_type = Allocator;
     RedBlackTree();
-    RedBlackTree(const RedBlackTree< Key, T, Compare > & rhs);
-    RedBlackTree(RedBlackTree< Key, T, Compare > && rhs) noexcept;
+    explicit RedBlackTree(const Allocator & alloc);
+    RedBlackTree(const RedBlackTree< Key, T, Compare, Allocator, Augment > & rhs);
+    RedBlackTree(RedBlackTree< Key, T, Compare, Allocator, Augment > && rhs) noexcept;
     RedBlackTree(std::initializer_list< value_type > init_list);
     template< class InputIt>
     RedBlackTree(InputIt first, InputIt last);
     ~RedBlackTree();
-    RedBlackTree< Key, T, Compare > & operator=(const RedBlackTree< Key, T, Compare > & rhs);
-    RedBlackTree< Key, T, Compare > & operator=(RedBlackTree< Key, T, Compare > && rhs) noexcept;
+    RedBlackTree< Key, T, Compare, Allocator, Augment > & operator=(const RedBlackTree< Key, T, Compare, Allocator, Augment > & rhs);
+    RedBlackTree< Key, T, Compare, Allocator, Augment > & operator=(RedBlackTree< Key, T, Compare, Allocator, Augment > && rhs) noexcept;
     T & operator[](const Key & key);
     const T & operator[](const Key & key) const;
     iterator begin();
@@ -66,6 +73,8 @@ namespace erohin
     template< class InputIt>
     void insert(InputIt first, InputIt last);
     void insert(std::initializer_list< value_type > init_list);
+    template< class ForwardIt >
+    void assign_sorted(ForwardIt first, ForwardIt last);
     template< class... Args >
     std::pair< iterator, bool > emplace(Args &&... args);
     template< class... Args >
@@ -88,6 +97,8 @@ namespace erohin
     const_iterator upper_bound(const Key & key) const;
     std::pair< iterator, iterator > equal_range(const Key & key);
     std::pair< const_iterator, const_iterator > equal_range(const Key & key) const;
+    allocator_type get_allocator() const;
+    typename Augment::value_type aggregate() const;
     template< class F >
     F traverse_lnr(F f) const;
     template< class F >
@@ -95,21 +106,29 @@ namespace erohin
     template< class F >
     F traverse_breadth(F f) const;
   private:
+    using node_type = detail::AugmentedTreeNode< Key, T, Augment >;
     detail::TreeNode< Key, T > * root_;
     size_t size_;
     Compare cmp_;
+    detail::NodePool< node_type, Allocator > pool_;
     char fake_[sizeof(detail::TreeNode< Key, T >)];
     detail::TreeNode< Key, T > * make_fake_node() const;
+    template< class InputIt >
+    void construct_from_range(InputIt first, InputIt last, std::input_iterator_tag);
+    template< class ForwardIt >
+    void construct_from_range(ForwardIt first, ForwardIt last, std::forward_iterator_tag);
+    template< class InputIt >
+    detail::TreeNode< Key, T > * build_sorted(InputIt & first, size_t count, size_t depth, size_t red_depth);
     void clear_subtree(detail::TreeNode< Key, T > * subtree);
-    detail::TreeNode< Key, T > * find_to_change_erased(detail::TreeNode< Key, T > * subtree);
+    void destroy_node(detail::TreeNode< Key, T > * node);
+    void refresh_path(detail::TreeNode< Key, T > * node);
+    void transplant(detail::TreeNode< Key, T > * subtree, detail::TreeNode< Key, T > * node);
     detail::TreeNode< Key, T > * find_grandparent(detail::TreeNode< Key, T > * subtree);
     detail::TreeNode< Key, T > * find_uncle(detail::TreeNode< Key, T > * subtree);
-    detail::TreeNode< Key, T > * find_brother(detail::TreeNode< Key, T > * subtree);
     template< detail::color_t C >
     bool is_color(detail::TreeNode< Key, T > * node);
     template< detail::color_t C >
     void colorize(detail::TreeNode< Key, T > * node);
-    bool is_leaf(detail::TreeNode< Key, T > * node);
     void rotate_left(detail::TreeNode< Key, T > * subtree);
     void rotate_right(detail::TreeNode< Key, T > * subtree);
     void insert_balance_case1(detail::TreeNode< Key, T > * subtree);
@@ -117,96 +136,93 @@ namespace erohin
     void insert_balance_case3(detail::TreeNode< Key, T > * subtree);
     void insert_balance_case4(detail::TreeNode< Key, T > * subtree);
     void insert_balance_case5(detail::TreeNode< Key, T > * subtree);
-    void erase_balance_case1(detail::TreeNode< Key, T > * subtree);
-    void erase_balance_case2(detail::TreeNode< Key, T > * subtree);
-    void erase_balance_case3(detail::TreeNode< Key, T > * subtree);
-    void erase_balance_case4(detail::TreeNode< Key, T > * subtree);
-    void erase_balance_case5(detail::TreeNode< Key, T > * subtree);
-    void erase_balance_case6(detail::TreeNode< Key, T > * subtree);
+    void erase_balance(detail::TreeNode< Key, T > * subtree, detail::TreeNode< Key, T > * parent);
   };
 
-  template< class Key, class T, class Compare >
-  RedBlackTree< Key, T, Compare >::RedBlackTree():
-    root_(nullptr),
-    size_(0)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  RedBlackTree< Key, T, Compare, Allocator, Augment >::RedBlackTree():
+    RedBlackTree(Allocator())
   {}
 
-  template< class Key, class T, class Compare >
-  RedBlackTree< Key, T, Compare >::RedBlackTree(const RedBlackTree< Key, T, Compare > & rhs):
-    RedBlackTree(rhs.cbegin(), rhs.cend())
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  RedBlackTree< Key, T, Compare, Allocator, Augment >::RedBlackTree(const Allocator & alloc):
+    root_(nullptr),
+    size_(0),
+    cmp_(),
+    pool_(alloc)
   {}
 
-  template< class Key, class T, class Compare >
-  RedBlackTree< Key, T, Compare >::RedBlackTree(RedBlackTree< Key, T, Compare > && rhs) noexcept:
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  RedBlackTree< Key, T, Compare, Allocator, Augment >::RedBlackTree(const RedBlackTree< Key, T, Compare, Allocator, Augment > & rhs):
+    RedBlackTree(std::allocator_traits< Allocator >::select_on_container_copy_construction(rhs.get_allocator()))
+  {
+    cmp_ = rhs.cmp_;
+    assign_sorted(rhs.cbegin(), rhs.cend());
+  }
+
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  RedBlackTree< Key, T, Compare, Allocator, Augment >::RedBlackTree(RedBlackTree< Key, T, Compare, Allocator, Augment > && rhs) noexcept:
     root_(rhs.root_),
-    size_(rhs.size_)
+    size_(rhs.size_),
+    cmp_(rhs.cmp_),
+    pool_(std::move(rhs.pool_))
   {
     rhs.root_ = nullptr;
     rhs.size_ = 0;
   }
 
-  template< class Key, class T, class Compare >
-  RedBlackTree< Key, T, Compare >::RedBlackTree(std::initializer_list< value_type > init_list):
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  RedBlackTree< Key, T, Compare, Allocator, Augment >::RedBlackTree(std::initializer_list< value_type > init_list):
     RedBlackTree(init_list.begin(), init_list.end())
   {}
 
-  template< class Key, class T, class Compare >
+  template< class Key, class T, class Compare, class Allocator, class Augment >
   template< class InputIt >
-  RedBlackTree< Key, T, Compare >::RedBlackTree(InputIt first, InputIt last):
-    root_(nullptr)
+  RedBlackTree< Key, T, Compare, Allocator, Augment >::RedBlackTree(InputIt first, InputIt last):
+    RedBlackTree()
   {
-    while (first != last)
-    {
-      try
-      {
-        insert(*(first++));
-      }
-      catch (...)
-      {
-        clear();
-      }
-    }
+    construct_from_range(first, last, typename std::iterator_traits< InputIt >::iterator_category());
   }
 
-  template< class Key, class T, class Compare >
-  RedBlackTree< Key, T, Compare >::~RedBlackTree()
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  RedBlackTree< Key, T, Compare, Allocator, Augment >::~RedBlackTree()
   {
     clear();
   }
 
-  template< class Key, class T, class Compare >
-  RedBlackTree< Key, T, Compare > & RedBlackTree< Key, T, Compare >::operator=(const RedBlackTree< Key, T, Compare > & rhs)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  RedBlackTree< Key, T, Compare, Allocator, Augment > & RedBlackTree< Key, T, Compare, Allocator, Augment >::operator=(const RedBlackTree< Key, T, Compare, Allocator, Augment > & rhs)
   {
-    return operator=(RedBlackTree< Key, T, Compare >(rhs));
+    return operator=(RedBlackTree< Key, T, Compare, Allocator, Augment >(rhs));
   }
 
-  template< class Key, class T, class Compare >
-  RedBlackTree< Key, T, Compare > & RedBlackTree< Key, T, Compare >::operator=(RedBlackTree< Key, T, Compare > && rhs) noexcept
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  RedBlackTree< Key, T, Compare, Allocator, Augment > & RedBlackTree< Key, T, Compare, Allocator, Augment >::operator=(RedBlackTree< Key, T, Compare, Allocator, Augment > && rhs) noexcept
   {
     if (std::addressof(rhs) != this)
     {
-      RedBlackTree< Key, T, Compare > temp(std::move(rhs));
+      RedBlackTree< Key, T, Compare, Allocator, Augment > temp(std::move(rhs));
       swap(temp);
     }
     return *this;
   }
 
-  template< class Key, class T, class Compare >
-  T & RedBlackTree< Key, T, Compare >::operator[](const Key & key)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  T & RedBlackTree< Key, T, Compare, Allocator, Augment >::operator[](const Key & key)
   {
     auto iter = insert(std::make_pair(key, T())).first;
     return iter->second;
   }
 
-  template< class Key, class T, class Compare >
-  const T & RedBlackTree< Key, T, Compare >::operator[](const Key & key) const
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  const T & RedBlackTree< Key, T, Compare, Allocator, Augment >::operator[](const Key & key) const
   {
     TreeConstIterator< Key, T > iter = find(key);
     return iter->second;
   }
 
-  template< class Key, class T, class Compare >
-  TreeIterator< Key, T > RedBlackTree< Key, T, Compare >::begin()
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  TreeIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::begin()
   {
     detail::TreeNode< Key, T > * result = root_;
     while (result && result->left)
@@ -216,14 +232,14 @@ namespace erohin
     return iterator(result);
   }
 
-  template< class Key, class T, class Compare >
-  TreeIterator< Key, T > RedBlackTree< Key, T, Compare >::end()
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  TreeIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::end()
   {
     return iterator(nullptr);
   }
 
-  template< class Key, class T, class Compare >
-  TreeConstIterator< Key, T > RedBlackTree< Key, T, Compare >::cbegin() const
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  TreeConstIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::cbegin() const
   {
     const detail::TreeNode< Key, T > * result = root_;
     while (result && result->left)
@@ -233,26 +249,26 @@ namespace erohin
     return const_iterator(result);
   }
 
-  template< class Key, class T, class Compare >
-  TreeConstIterator< Key, T > RedBlackTree< Key, T, Compare >::cend() const
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  TreeConstIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::cend() const
   {
     return const_iterator(nullptr);
   }
 
-  template< class Key, class T, class Compare >
-  typename RedBlackTree< Key, T, Compare >::reverse_iterator RedBlackTree< Key, T, Compare >::rbegin()
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  typename RedBlackTree< Key, T, Compare, Allocator, Augment >::reverse_iterator RedBlackTree< Key, T, Compare, Allocator, Augment >::rbegin()
   {
     return reverse_iterator(iterator(crbegin().node_));
   }
 
-  template< class Key, class T, class Compare >
-  typename RedBlackTree< Key, T, Compare >::reverse_iterator RedBlackTree< Key, T, Compare >::rend()
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  typename RedBlackTree< Key, T, Compare, Allocator, Augment >::reverse_iterator RedBlackTree< Key, T, Compare, Allocator, Augment >::rend()
   {
     return reverse_iterator(iterator(crend().node_));
   }
 
-  template< class Key, class T, class Compare >
-  typename RedBlackTree< Key, T, Compare >::const_reverse_iterator RedBlackTree< Key, T, Compare >::crbegin() const
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  typename RedBlackTree< Key, T, Compare, Allocator, Augment >::const_reverse_iterator RedBlackTree< Key, T, Compare, Allocator, Augment >::crbegin() const
   {
     detail::TreeNode< Key, T > * prev = root_;
     while (prev->right)
@@ -265,14 +281,14 @@ namespace erohin
     return const_reverse_iterator(const_iterator(result));
   }
 
-  template< class Key, class T, class Compare >
-  typename RedBlackTree< Key, T, Compare >::const_reverse_iterator RedBlackTree< Key, T, Compare >::crend() const
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  typename RedBlackTree< Key, T, Compare, Allocator, Augment >::const_reverse_iterator RedBlackTree< Key, T, Compare, Allocator, Augment >::crend() const
   {
     return const_reverse_iterator(const_iterator(cbegin().node_));
   }
 
-  template< class Key, class T, class Compare >
-  LnrIterator< Key, T > RedBlackTree< Key, T, Compare >::lnr_begin()
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  LnrIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::lnr_begin()
   {
     auto iter = lnr_iterator(root_);
     while (iter.node_->left)
@@ -283,14 +299,14 @@ namespace erohin
     return iter;
   }
 
-  template< class Key, class T, class Compare >
-  LnrIterator< Key, T > RedBlackTree< Key, T, Compare >::lnr_end()
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  LnrIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::lnr_end()
   {
     return lnr_iterator(nullptr);
   }
 
-  template< class Key, class T, class Compare >
-  ConstLnrIterator< Key, T > RedBlackTree< Key, T, Compare >::lnr_cbegin() const
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  ConstLnrIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::lnr_cbegin() const
   {
     auto iter = const_lnr_iterator(root_);
     while (iter.node_->left)
@@ -301,26 +317,26 @@ namespace erohin
     return iter;
   }
 
-  template< class Key, class T, class Compare >
-  ConstLnrIterator< Key, T > RedBlackTree< Key, T, Compare >::lnr_cend() const
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  ConstLnrIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::lnr_cend() const
   {
     return const_lnr_iterator(nullptr);
   }
 
-  template< class Key, class T, class Compare >
-  typename RedBlackTree< Key, T, Compare >::rnl_iterator RedBlackTree< Key, T, Compare >::rnl_begin()
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  typename RedBlackTree< Key, T, Compare, Allocator, Augment >::rnl_iterator RedBlackTree< Key, T, Compare, Allocator, Augment >::rnl_begin()
   {
     return rnl_iterator(rnl_cbegin().iter_);
   }
 
-  template< class Key, class T, class Compare >
-  typename RedBlackTree< Key, T, Compare >::rnl_iterator RedBlackTree< Key, T, Compare >::rnl_end()
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  typename RedBlackTree< Key, T, Compare, Allocator, Augment >::rnl_iterator RedBlackTree< Key, T, Compare, Allocator, Augment >::rnl_end()
   {
     return rnl_iterator(rnl_cend().iter_);
   }
 
-  template< class Key, class T, class Compare >
-  typename RedBlackTree< Key, T, Compare >::const_rnl_iterator RedBlackTree< Key, T, Compare >::rnl_cbegin() const
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  typename RedBlackTree< Key, T, Compare, Allocator, Augment >::const_rnl_iterator RedBlackTree< Key, T, Compare, Allocator, Augment >::rnl_cbegin() const
   {
     auto iter = const_lnr_iterator(root_);
     while (iter.node_->right)
@@ -331,57 +347,58 @@ namespace erohin
     return const_rnl_iterator(iter);
   }
 
-  template< class Key, class T, class Compare >
-  typename RedBlackTree< Key, T, Compare >::const_rnl_iterator RedBlackTree< Key, T, Compare >::rnl_cend() const
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  typename RedBlackTree< Key, T, Compare, Allocator, Augment >::const_rnl_iterator RedBlackTree< Key, T, Compare, Allocator, Augment >::rnl_cend() const
   {
     return const_rnl_iterator(nullptr);
   }
 
-  template< class Key, class T, class Compare >
-  BreadthIterator< Key, T > RedBlackTree< Key, T, Compare >::breadth_begin()
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  BreadthIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::breadth_begin()
   {
     return breadth_iterator(root_);
   }
 
-  template< class Key, class T, class Compare >
-  BreadthIterator< Key, T > RedBlackTree< Key, T, Compare >::breadth_end()
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  BreadthIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::breadth_end()
   {
     return breadth_iterator(nullptr);
   }
 
-  template< class Key, class T, class Compare >
-  ConstBreadthIterator< Key, T > RedBlackTree< Key, T, Compare >::breadth_cbegin() const
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  ConstBreadthIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::breadth_cbegin() const
   {
     return const_breadth_iterator(root_);
   }
 
-  template< class Key, class T, class Compare >
-  ConstBreadthIterator< Key, T > RedBlackTree< Key, T, Compare >::breadth_cend() const
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  ConstBreadthIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::breadth_cend() const
   {
     return const_breadth_iterator(nullptr);
   }
 
-  template< class Key, class T, class Compare >
-  void RedBlackTree< Key, T, Compare >::clear()
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  void RedBlackTree< Key, T, Compare, Allocator, Augment >::clear()
   {
     clear_subtree(root_);
+    pool_.release();
     root_ = nullptr;
     size_ = 0;
   }
 
-  template< class Key, class T, class Compare >
-  std::pair< TreeIterator< Key, T >, bool > RedBlackTree< Key, T, Compare >::insert(const value_type & value)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  std::pair< TreeIterator< Key, T >, bool > RedBlackTree< Key, T, Compare, Allocator, Augment >::insert(const value_type & value)
   {
     return insert(value_type(value));
   }
 
-  template< class Key, class T, class Compare >
-  std::pair< TreeIterator< Key, T >, bool > RedBlackTree< Key, T, Compare >::insert(value_type && value)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  std::pair< TreeIterator< Key, T >, bool > RedBlackTree< Key, T, Compare, Allocator, Augment >::insert(value_type && value)
   {
     detail::TreeNode< Key, T > * node = root_;
     if (empty())
     {
-      root_ = new detail::TreeNode< Key, T >(nullptr, nullptr, nullptr, std::move(value));
+      root_ = pool_.create(nullptr, nullptr, nullptr, std::move(value));
       node = root_;
     }
     else
@@ -403,7 +420,7 @@ namespace erohin
           node = node->right;
         }
       }
-      node = new detail::TreeNode< Key, T >(prev, nullptr, nullptr, std::move(value));
+      node = pool_.create(prev, nullptr, nullptr, std::move(value));
       try
       {
         if (cmp_(node->data.first, prev->data.first))
@@ -417,23 +434,24 @@ namespace erohin
       }
       catch (...)
       {
-        delete node;
+        destroy_node(node);
         throw;
       }
     }
+    refresh_path(node);
     insert_balance_case1(node);
     ++size_;
     return std::make_pair(iterator(node), true);
   }
 
-  template< class Key, class T, class Compare >
-  TreeIterator< Key, T > RedBlackTree< Key, T, Compare >::insert(iterator pos, const value_type & value)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  TreeIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::insert(iterator pos, const value_type & value)
   {
     return insert(pos, value_type(value));
   }
 
-  template< class Key, class T, class Compare >
-  TreeIterator< Key, T > RedBlackTree< Key, T, Compare >::insert(iterator pos, value_type && value)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  TreeIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::insert(iterator pos, value_type && value)
   {
     detail::TreeNode< Key, T > * node = pos.node_;
     detail::TreeNode< Key, T > * prev = node;
@@ -449,7 +467,7 @@ namespace erohin
         node = node->right;
       }
     }
-    node = new detail::TreeNode< Key, T >(prev, nullptr, nullptr, std::move(value));
+    node = pool_.create(prev, nullptr, nullptr, std::move(value));
     try
     {
       if (cmp_(node->data.first, prev->data.first))
@@ -463,17 +481,18 @@ namespace erohin
     }
     catch (...)
     {
-      delete node;
+      destroy_node(node);
       throw;
     }
+    refresh_path(node);
     insert_balance_case1(node);
     ++size_;
     return iterator(node);
   }
 
-  template< class Key, class T, class Compare >
+  template< class Key, class T, class Compare, class Allocator, class Augment >
   template< class InputIt >
-  void RedBlackTree< Key, T, Compare >::insert(InputIt first, InputIt last)
+  void RedBlackTree< Key, T, Compare, Allocator, Augment >::insert(InputIt first, InputIt last)
   {
     while (first != last)
     {
@@ -481,17 +500,36 @@ namespace erohin
     }
   }
 
-  template< class Key, class T, class Compare >
-  void RedBlackTree< Key, T, Compare >::insert(std::initializer_list< value_type > init_list)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  void RedBlackTree< Key, T, Compare, Allocator, Augment >::insert(std::initializer_list< value_type > init_list)
   {
     insert(init_list.begin(), init_list.end());
   }
 
-  template< class Key, class T, class Compare >
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  template< class ForwardIt >
+  void RedBlackTree< Key, T, Compare, Allocator, Augment >::assign_sorted(ForwardIt first, ForwardIt last)
+  {
+    size_t count = 0;
+    for (ForwardIt iter = first; iter != last; ++iter)
+    {
+      ++count;
+    }
+    size_t red_depth = 0;
+    while ((size_t(2) << red_depth) - 1 <= count)
+    {
+      ++red_depth;
+    }
+    clear();
+    root_ = build_sorted(first, count, 0, red_depth);
+    size_ = count;
+  }
+
+  template< class Key, class T, class Compare, class Allocator, class Augment >
   template< class... Args >
-  std::pair< TreeIterator< Key, T >, bool > RedBlackTree< Key, T, Compare >::emplace(Args &&... args)
+  std::pair< TreeIterator< Key, T >, bool > RedBlackTree< Key, T, Compare, Allocator, Augment >::emplace(Args &&... args)
   {
-    detail::TreeNode< Key, T > * emplaced = new detail::TreeNode< Key, T >(nullptr, nullptr, nullptr, std::forward< Args... >(args...));
+    detail::TreeNode< Key, T > * emplaced = pool_.create(nullptr, nullptr, nullptr, std::forward< Args... >(args...));
     try
     {
       if (empty())
@@ -507,7 +545,7 @@ namespace erohin
           prev = node;
           if (!cmp_(emplaced->data.first, node->data.first) && !cmp_(node->data.first, emplaced->data.first))
           {
-            delete emplaced;
+            destroy_node(emplaced);
             return std::make_pair(iterator(node), false);
           }
           else if (cmp_(emplaced->data.first, node->data.first))
@@ -532,19 +570,20 @@ namespace erohin
     }
     catch (...)
     {
-      delete emplaced;
+      destroy_node(emplaced);
       throw;
     }
+    refresh_path(emplaced);
     insert_balance_case1(emplaced);
     ++size_;
     return std::make_pair(iterator(emplaced), true);
   }
 
-  template< class Key, class T, class Compare >
+  template< class Key, class T, class Compare, class Allocator, class Augment >
   template< class... Args >
-  TreeIterator< Key, T > RedBlackTree< Key, T, Compare >::emplace_hint(const_iterator pos, Args &&... args)
+  TreeIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::emplace_hint(const_iterator pos, Args &&... args)
   {
-    detail::TreeNode< Key, T > * emplaced = new detail::TreeNode< Key, T >(nullptr, nullptr, nullptr, std::forward< Args... >(args...));
+    detail::TreeNode< Key, T > * emplaced = pool_.create(nullptr, nullptr, nullptr, std::forward< Args... >(args...));
     try
     {
       detail::TreeNode< Key, T > * node = pos.node_;
@@ -554,7 +593,7 @@ namespace erohin
         prev = node;
         if (!cmp_(emplaced->first, node->data.first) && !cmp_(node->data.first, emplaced->first))
         {
-          delete emplaced;
+          destroy_node(emplaced);
           return std::make_pair(iterator(node), false);
         }
         else if (cmp_(emplaced->first, node->data.first))
@@ -578,16 +617,17 @@ namespace erohin
     }
     catch (...)
     {
-      delete emplaced;
+      destroy_node(emplaced);
       throw;
     }
+    refresh_path(emplaced);
     insert_balance_case1(emplaced);
     ++size_;
     return std::make_pair(iterator(emplaced), true);
   }
 
-  template< class Key, class T, class Compare >
-  TreeIterator< Key, T > RedBlackTree< Key, T, Compare >::erase(const Key & key)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  TreeIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::erase(const Key & key)
   {
     detail::TreeNode< Key, T > * node = root_;
     detail::TreeNode< Key, T > * to_delete = nullptr;
@@ -613,47 +653,62 @@ namespace erohin
     return erase(iterator(to_delete));
   }
 
-  template< class Key, class T, class Compare >
-  TreeIterator< Key, T > RedBlackTree< Key, T, Compare >::erase(iterator pos)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  TreeIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::erase(iterator pos)
   {
-    detail::TreeNode< Key, T > * to_delete = pos.node_;
-    detail::TreeNode< Key, T > * found = find_to_change_erased(to_delete);
-    if (to_delete == root_ && !found)
-    {
-      clear();
-      return end();
-    }
-    else if (!found)
-    {
-      found = to_delete;
-    }
-    if (found->parent->left == found)
+    using namespace detail;
+    TreeNode< Key, T > * to_delete = pos.node_;
+    TreeNode< Key, T > * moved = to_delete;
+    TreeNode< Key, T > * child = nullptr;
+    TreeNode< Key, T > * child_parent = nullptr;
+    color_t erased_color = moved->color;
+    auto iter = ++pos;
+    if (!to_delete->left || !to_delete->right)
     {
-      found->parent->left = found->left;
+      child = (to_delete->left) ? to_delete->left : to_delete->right;
+      child_parent = to_delete->parent;
+      transplant(to_delete, child);
     }
-    else if (found->parent->right == found)
+    else
     {
-      found->parent->right = found->right;
+      moved = to_delete->right;
+      while (moved->left)
+      {
+        moved = moved->left;
+      }
+      erased_color = moved->color;
+      child = moved->right;
+      child_parent = moved;
+      if (moved->parent != to_delete)
+      {
+        child_parent = moved->parent;
+        transplant(moved, moved->right);
+        moved->right = to_delete->right;
+        moved->right->parent = moved;
+      }
+      transplant(to_delete, moved);
+      moved->left = to_delete->left;
+      moved->left->parent = moved;
+      moved->color = to_delete->color;
     }
-    if (found != to_delete)
+    refresh_path(child_parent);
+    if (erased_color == BLACK)
     {
-      std::swap(found->data, to_delete->data);
+      erase_balance(child, child_parent);
     }
-    erase_balance_case1(found);
-    auto iter = ++pos;
-    delete found;
+    destroy_node(to_delete);
     --size_;
     return iter;
   }
 
-  template< class Key, class T, class Compare >
-  TreeIterator< Key, T > RedBlackTree< Key, T, Compare >::erase(const_iterator pos)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  TreeIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::erase(const_iterator pos)
   {
     return TreeConstIterator< Key, T >(erase(iterator(pos.node_)));
   }
 
-  template< class Key, class T, class Compare >
-  TreeIterator< Key, T > RedBlackTree< Key, T, Compare >::erase(iterator first, iterator last)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  TreeIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::erase(iterator first, iterator last)
   {
     iterator result;
     while (first != last)
@@ -663,32 +718,35 @@ namespace erohin
     return result;
   }
 
-  template< class Key, class T, class Compare >
-  TreeIterator< Key, T > RedBlackTree< Key, T, Compare >::erase(const_iterator first, const_iterator last)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  TreeIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::erase(const_iterator first, const_iterator last)
   {
     return erase(iterator(first.node_), iterator(last.node_));
   }
 
-  template< class Key, class T, class Compare >
-  bool RedBlackTree< Key, T, Compare >::empty() const noexcept
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  bool RedBlackTree< Key, T, Compare, Allocator, Augment >::empty() const noexcept
   {
     return (!root_);
   }
 
-  template< class Key, class T, class Compare >
-  void RedBlackTree< Key, T, Compare >::swap(RedBlackTree< Key, T, Compare > & rhs) noexcept
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  void RedBlackTree< Key, T, Compare, Allocator, Augment >::swap(RedBlackTree< Key, T, Compare, Allocator, Augment > & rhs) noexcept
   {
     std::swap(root_, rhs.root_);
+    std::swap(size_, rhs.size_);
+    std::swap(cmp_, rhs.cmp_);
+    pool_.swap(rhs.pool_);
   }
 
-  template< class Key, class T, class Compare >
-  size_t RedBlackTree< Key, T, Compare >::size() const noexcept
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  size_t RedBlackTree< Key, T, Compare, Allocator, Augment >::size() const noexcept
   {
     return size_;
   }
 
-  template< class Key, class T, class Compare >
-  size_t RedBlackTree< Key, T, Compare >::count(const Key & key) const
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  size_t RedBlackTree< Key, T, Compare, Allocator, Augment >::count(const Key & key) const
   {
     auto citer = cbegin();
     size_t size = 0;
@@ -702,8 +760,8 @@ namespace erohin
     return size;
   }
 
-  template< class Key, class T, class Compare >
-  TreeIterator< Key, T > RedBlackTree< Key, T, Compare >::find(const Key & key)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  TreeIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::find(const Key & key)
   {
     detail::TreeNode< Key, T > * node = root_;
     while (node)
@@ -724,8 +782,8 @@ namespace erohin
     return end();
   }
 
-  template< class Key, class T, class Compare >
-  TreeConstIterator< Key, T > RedBlackTree< Key, T, Compare >::find(const Key & key) const
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  TreeConstIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::find(const Key & key) const
   {
     const detail::TreeNode< Key, T > * node = root_;
     while (node)
@@ -746,8 +804,8 @@ namespace erohin
     return cend();
   }
 
-  template< class Key, class T, class Compare >
-  T & RedBlackTree< Key, T, Compare >::at(const Key & key)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  T & RedBlackTree< Key, T, Compare, Allocator, Augment >::at(const Key & key)
   {
     TreeIterator< Key, T > iter = find(key);
     if (iter == end())
@@ -757,8 +815,8 @@ namespace erohin
     return iter->second;
   }
 
-  template< class Key, class T, class Compare >
-  const T & RedBlackTree< Key, T, Compare >::at(const Key & key) const
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  const T & RedBlackTree< Key, T, Compare, Allocator, Augment >::at(const Key & key) const
   {
     TreeConstIterator< Key, T > iter = find(key);
     if (iter == cend())
@@ -768,8 +826,8 @@ namespace erohin
     return iter->second;
   }
 
-  template< class Key, class T, class Compare >
-  TreeIterator< Key, T > RedBlackTree< Key, T, Compare >::lower_bound(const Key & key)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  TreeIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::lower_bound(const Key & key)
   {
     detail::TreeNode< Key, T > * node = root_;
     detail::TreeNode< Key, T > * prev = root_;
@@ -792,14 +850,14 @@ namespace erohin
     return end();
   }
 
-  template< class Key, class T, class Compare >
-  TreeConstIterator< Key, T > RedBlackTree< Key, T, Compare >::lower_bound(const Key & key) const
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  TreeConstIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::lower_bound(const Key & key) const
   {
     return const_iterator(lower_bound(key).node_);
   }
 
-  template< class Key, class T, class Compare >
-  TreeIterator< Key, T > RedBlackTree< Key, T, Compare >::upper_bound(const Key & key)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  TreeIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::upper_bound(const Key & key)
   {
     detail::TreeNode< Key, T > * node = root_;
     while (node)
@@ -820,68 +878,170 @@ namespace erohin
     return end();
   }
 
-  template< class Key, class T, class Compare >
-  TreeConstIterator< Key, T > RedBlackTree< Key, T, Compare >::upper_bound(const Key & key) const
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  TreeConstIterator< Key, T > RedBlackTree< Key, T, Compare, Allocator, Augment >::upper_bound(const Key & key) const
   {
     return const_iterator(upper_bound(key).node_);
   }
 
-  template< class Key, class T, class Compare >
-  std::pair< TreeIterator< Key, T >, TreeIterator< Key, T > > RedBlackTree< Key, T, Compare >::equal_range(const Key & key)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  std::pair< TreeIterator< Key, T >, TreeIterator< Key, T > > RedBlackTree< Key, T, Compare, Allocator, Augment >::equal_range(const Key & key)
   {
     return std::make_pair(lower_bound(key), upper_bound(key));
   }
 
-  template< class Key, class T, class Compare >
-  std::pair< TreeConstIterator< Key, T >, TreeConstIterator< Key, T > > RedBlackTree< Key, T, Compare >::equal_range(const Key & key) const
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  std::pair< TreeConstIterator< Key, T >, TreeConstIterator< Key, T > > RedBlackTree< Key, T, Compare, Allocator, Augment >::equal_range(const Key & key) const
   {
     return std::make_pair(lower_bound(key), upper_bound(key));
   }
 
-  template< class Key, class T, class Compare >
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  Allocator RedBlackTree< Key, T, Compare, Allocator, Augment >::get_allocator() const
+  {
+    return pool_.get_allocator();
+  }
+
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  typename Augment::value_type RedBlackTree< Key, T, Compare, Allocator, Augment >::aggregate() const
+  {
+    if (!root_)
+    {
+      return Augment::identity();
+    }
+    return static_cast< const node_type * >(root_)->aggregate;
+  }
+
+  template< class Key, class T, class Compare, class Allocator, class Augment >
   template< class F >
-  F RedBlackTree< Key, T, Compare >::traverse_lnr(F f) const
+  F RedBlackTree< Key, T, Compare, Allocator, Augment >::traverse_lnr(F f) const
   {
     auto citer = lnr_cbegin();
     while (citer != lnr_cend())
     {
-      f = f(*(citer++));
+      f(*(citer++));
     }
     return f;
   }
 
-  template< class Key, class T, class Compare >
+  template< class Key, class T, class Compare, class Allocator, class Augment >
   template< class F >
-  F RedBlackTree< Key, T, Compare >::traverse_rnl(F f) const
+  F RedBlackTree< Key, T, Compare, Allocator, Augment >::traverse_rnl(F f) const
   {
     auto citer = rnl_cbegin();
     while (citer != rnl_cend())
     {
-      f = f(*(citer++));
+      f(*(citer++));
     }
     return f;
   }
 
-  template< class Key, class T, class Compare >
+  template< class Key, class T, class Compare, class Allocator, class Augment >
   template< class F >
-  F RedBlackTree< Key, T, Compare >::traverse_breadth(F f) const
+  F RedBlackTree< Key, T, Compare, Allocator, Augment >::traverse_breadth(F f) const
   {
     auto citer = breadth_cbegin();
     while (citer != breadth_cend())
     {
-      f = f(*(citer++));
+      f(*(citer++));
     }
     return f;
   }
 
-  template< class Key, class T, class Compare >
-  detail::TreeNode< Key, T > * RedBlackTree< Key, T, Compare >::make_fake_node() const
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  detail::TreeNode< Key, T > * RedBlackTree< Key, T, Compare, Allocator, Augment >::make_fake_node() const
   {
     return reinterpret_cast< detail::TreeNode< Key, T > * >(const_cast< char * >(fake_));
   }
 
-  template< class Key, class T, class Compare >
-  void RedBlackTree< Key, T, Compare >::clear_subtree(detail::TreeNode< Key, T > * subtree)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  template< class InputIt >
+  void RedBlackTree< Key, T, Compare, Allocator, Augment >::construct_from_range(InputIt first, InputIt last, std::input_iterator_tag)
+  {
+    while (first != last)
+    {
+      try
+      {
+        insert(*(first++));
+      }
+      catch (...)
+      {
+        clear();
+      }
+    }
+  }
+
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  template< class ForwardIt >
+  void RedBlackTree< Key, T, Compare, Allocator, Augment >::construct_from_range(ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+  {
+    bool is_sorted = true;
+    if (first != last)
+    {
+      ForwardIt prev = first;
+      ForwardIt iter = first;
+      ++iter;
+      while (is_sorted && iter != last)
+      {
+        is_sorted = cmp_((*prev).first, (*iter).first);
+        prev = iter++;
+      }
+    }
+    if (is_sorted)
+    {
+      assign_sorted(first, last);
+    }
+    else
+    {
+      construct_from_range(first, last, std::input_iterator_tag());
+    }
+  }
+
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  template< class InputIt >
+  detail::TreeNode< Key, T > * RedBlackTree< Key, T, Compare, Allocator, Augment >::build_sorted(InputIt & first, size_t count, size_t depth, size_t red_depth)
+  {
+    if (count == 0)
+    {
+      return nullptr;
+    }
+    size_t left_count = count / 2;
+    detail::TreeNode< Key, T > * left = build_sorted(first, left_count, depth + 1, red_depth);
+    detail::TreeNode< Key, T > * node = nullptr;
+    try
+    {
+      node = pool_.create(nullptr, left, nullptr, *first);
+    }
+    catch (...)
+    {
+      clear_subtree(left);
+      throw;
+    }
+    ++first;
+    node->color = (depth == red_depth) ? detail::RED : detail::BLACK;
+    if (left)
+    {
+      left->parent = node;
+    }
+    try
+    {
+      node->right = build_sorted(first, count - left_count - 1, depth + 1, red_depth);
+    }
+    catch (...)
+    {
+      clear_subtree(node);
+      throw;
+    }
+    if (node->right)
+    {
+      node->right->parent = node;
+    }
+    detail::refreshAggregate(node, Augment());
+    return node;
+  }
+
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  void RedBlackTree< Key, T, Compare, Allocator, Augment >::clear_subtree(detail::TreeNode< Key, T > * subtree)
   {
     if (!subtree)
     {
@@ -889,57 +1049,66 @@ namespace erohin
     }
     clear_subtree(subtree->left);
     clear_subtree(subtree->right);
-    delete subtree;
+    destroy_node(subtree);
   }
 
-  template< class Key, class T, class Compare >
-  detail::TreeNode< Key, T > * RedBlackTree< Key, T, Compare >::find_to_change_erased(detail::TreeNode< Key, T > * subtree)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  void RedBlackTree< Key, T, Compare, Allocator, Augment >::destroy_node(detail::TreeNode< Key, T > * node)
   {
-    if (subtree->left)
+    pool_.destroy(static_cast< node_type * >(node));
+  }
+
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  void RedBlackTree< Key, T, Compare, Allocator, Augment >::refresh_path(detail::TreeNode< Key, T > * node)
+  {
+    if (std::is_same< Augment, detail::NoAugment >::value)
     {
-      subtree = subtree->left;
-      while (subtree->right)
-      {
-        subtree = subtree->right;
-      }
+      return;
     }
-    else if (subtree->right)
+    while (node)
     {
-      subtree = subtree->right;
-      while (subtree->left)
-      {
-        subtree = subtree->left;
-      }
+      detail::refreshAggregate(node, Augment());
+      node = node->parent;
+    }
+  }
+
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  void RedBlackTree< Key, T, Compare, Allocator, Augment >::transplant(detail::TreeNode< Key, T > * subtree, detail::TreeNode< Key, T > * node)
+  {
+    if (!subtree->parent)
+    {
+      root_ = node;
+    }
+    else if (subtree == subtree->parent->left)
+    {
+      subtree->parent->left = node;
     }
     else
     {
-      subtree = nullptr;
+      subtree->parent->right = node;
+    }
+    if (node)
+    {
+      node->parent = subtree->parent;
     }
-    return subtree;
   }
 
-  template< class Key, class T, class Compare >
+  template< class Key, class T, class Compare, class Allocator, class Augment >
   template< detail::color_t C >
-  bool RedBlackTree< Key, T, Compare >::is_color(detail::TreeNode< Key, T > * node)
+  bool RedBlackTree< Key, T, Compare, Allocator, Augment >::is_color(detail::TreeNode< Key, T > * node)
   {
-    return (node->color == C);
+    return (node) ? (node->color == C) : (C == detail::BLACK);
   }
 
-  template< class Key, class T, class Compare >
+  template< class Key, class T, class Compare, class Allocator, class Augment >
   template< detail::color_t C >
-  void RedBlackTree< Key, T, Compare >::colorize(detail::TreeNode< Key, T > * node)
+  void RedBlackTree< Key, T, Compare, Allocator, Augment >::colorize(detail::TreeNode< Key, T > * node)
   {
     node->color = C;
   }
 
-  template< class Key, class T, class Compare >
-  bool RedBlackTree< Key, T, Compare >::is_leaf(detail::TreeNode< Key, T > * node)
-  {
-    return !(node->left && node->right);
-  }
-
-  template< class Key, class T, class Compare >
-  detail::TreeNode< Key, T > * RedBlackTree< Key, T, Compare >::find_grandparent(detail::TreeNode< Key, T > * subtree)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  detail::TreeNode< Key, T > * RedBlackTree< Key, T, Compare, Allocator, Augment >::find_grandparent(detail::TreeNode< Key, T > * subtree)
   {
     if (subtree && subtree->parent)
     {
@@ -951,15 +1120,15 @@ namespace erohin
     }
   }
 
-  template< class Key, class T, class Compare >
-  detail::TreeNode< Key, T > * RedBlackTree< Key, T, Compare >::find_uncle(detail::TreeNode< Key, T > * subtree)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  detail::TreeNode< Key, T > * RedBlackTree< Key, T, Compare, Allocator, Augment >::find_uncle(detail::TreeNode< Key, T > * subtree)
   {
     detail::TreeNode< Key, T > * node = find_grandparent(subtree);
     if (!node)
     {
       return nullptr;
     }
-    if (node->parent == node->left)
+    if (subtree->parent == node->left)
     {
       return node->right;
     }
@@ -969,21 +1138,8 @@ namespace erohin
     }
   }
 
-  template< class Key, class T, class Compare >
-  detail::TreeNode< Key, T > * RedBlackTree< Key, T, Compare >::find_brother(detail::TreeNode< Key, T > * subtree)
-  {
-    if (subtree == subtree->parent->left)
-    {
-      return subtree->parent->right;
-    }
-    else
-    {
-      return subtree->parent->left;
-    }
-  }
-
-  template< class Key, class T, class Compare >
-  void RedBlackTree< Key, T, Compare >::rotate_left(detail::TreeNode< Key, T > * subtree)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  void RedBlackTree< Key, T, Compare, Allocator, Augment >::rotate_left(detail::TreeNode< Key, T > * subtree)
   {
     detail::TreeNode< Key, T > * node = subtree->right;
     node->parent = subtree->parent;
@@ -1009,10 +1165,12 @@ namespace erohin
     }
     subtree->parent = node;
     node->left = subtree;
+    detail::refreshAggregate(subtree, Augment());
+    detail::refreshAggregate(node, Augment());
   }
 
-  template< class Key, class T, class Compare >
-  void RedBlackTree< Key, T, Compare >::rotate_right(detail::TreeNode< Key, T > * subtree)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  void RedBlackTree< Key, T, Compare, Allocator, Augment >::rotate_right(detail::TreeNode< Key, T > * subtree)
   {
     detail::TreeNode< Key, T > * node = subtree->left;
     node->parent = subtree->parent;
@@ -1038,10 +1196,12 @@ namespace erohin
     }
     subtree->parent = node;
     node->right = subtree;
+    detail::refreshAggregate(subtree, Augment());
+    detail::refreshAggregate(node, Augment());
   }
 
-  template< class Key, class T, class Compare >
-  void RedBlackTree< Key, T, Compare >::insert_balance_case1(detail::TreeNode< Key, T > * subtree)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  void RedBlackTree< Key, T, Compare, Allocator, Augment >::insert_balance_case1(detail::TreeNode< Key, T > * subtree)
   {
     using namespace detail;
     if (!subtree->parent)
@@ -1054,8 +1214,8 @@ namespace erohin
     }
   }
 
-  template< class Key, class T, class Compare >
-  void RedBlackTree< Key, T, Compare >::insert_balance_case2(detail::TreeNode< Key, T > * subtree)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  void RedBlackTree< Key, T, Compare, Allocator, Augment >::insert_balance_case2(detail::TreeNode< Key, T > * subtree)
   {
     using namespace detail;
     if (is_color< RED >(subtree->parent))
@@ -1064,8 +1224,8 @@ namespace erohin
     }
   }
 
-  template< class Key, class T, class Compare >
-  void RedBlackTree< Key, T, Compare >::insert_balance_case3(detail::TreeNode< Key, T > * subtree)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  void RedBlackTree< Key, T, Compare, Allocator, Augment >::insert_balance_case3(detail::TreeNode< Key, T > * subtree)
   {
     using namespace detail;
     TreeNode< Key, T > * uncle = find_uncle(subtree);
@@ -1083,8 +1243,8 @@ namespace erohin
     }
   }
 
-  template< class Key, class T, class Compare >
-  void RedBlackTree< Key, T, Compare >::insert_balance_case4(detail::TreeNode< Key, T > * subtree)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  void RedBlackTree< Key, T, Compare, Allocator, Augment >::insert_balance_case4(detail::TreeNode< Key, T > * subtree)
   {
     using namespace detail;
     TreeNode< Key, T > * grand = find_grandparent(subtree);
@@ -1101,8 +1261,8 @@ namespace erohin
     insert_balance_case5(subtree);
   }
 
-  template< class Key, class T, class Compare >
-  void RedBlackTree< Key, T, Compare >::insert_balance_case5(detail::TreeNode< Key, T > * subtree)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  void RedBlackTree< Key, T, Compare, Allocator, Augment >::insert_balance_case5(detail::TreeNode< Key, T > * subtree)
   {
     using namespace detail;
     TreeNode< Key, T > * grand = find_grandparent(subtree);
@@ -1118,118 +1278,80 @@ namespace erohin
     }
   }
 
-  template< class Key, class T, class Compare >
-  void RedBlackTree< Key, T, Compare >::erase_balance_case1(detail::TreeNode< Key, T > * subtree)
+  template< class Key, class T, class Compare, class Allocator, class Augment >
+  void RedBlackTree< Key, T, Compare, Allocator, Augment >::erase_balance(detail::TreeNode< Key, T > * subtree, detail::TreeNode< Key, T > * parent)
   {
     using namespace detail;
-    if (is_color< BLACK >(subtree) && !is_leaf(subtree))
+    while (subtree != root_ && is_color< BLACK >(subtree))
     {
-      TreeNode< Key, T > * child = (subtree->right) ? subtree->left : subtree->right;
-      if (is_color< RED >(child))
+      if (subtree == parent->left)
       {
-        colorize< BLACK >(child);
-      }
-      else if (subtree->parent)
-      {
-        erase_balance_case2(child);
-      }
-    }
-  }
-
-  template< class Key, class T, class Compare >
-  void RedBlackTree< Key, T, Compare >::erase_balance_case2(detail::TreeNode< Key, T > * subtree)
-  {
-    using namespace detail;
-    TreeNode< Key, T > * brother = find_brother(subtree);
-    if (is_color< RED >(brother))
-    {
-      colorize< RED >(subtree->parent);
-      colorize< BLACK >(brother);
-      if (subtree == subtree->parent->left)
-      {
-        rotate_left(subtree->parent);
+        TreeNode< Key, T > * brother = parent->right;
+        if (is_color< RED >(brother))
+        {
+          colorize< BLACK >(brother);
+          colorize< RED >(parent);
+          rotate_left(parent);
+          brother = parent->right;
+        }
+        if (is_color< BLACK >(brother->left) && is_color< BLACK >(brother->right))
+        {
+          colorize< RED >(brother);
+          subtree = parent;
+          parent = subtree->parent;
+        }
+        else
+        {
+          if (is_color< BLACK >(brother->right))
+          {
+            colorize< BLACK >(brother->left);
+            colorize< RED >(brother);
+            rotate_right(brother);
+            brother = parent->right;
+          }
+          brother->color = parent->color;
+          colorize< BLACK >(parent);
+          colorize< BLACK >(brother->right);
+          rotate_left(parent);
+          subtree = root_;
+        }
       }
       else
       {
-        rotate_right(subtree->parent);
-      }
-    }
-    erase_balance_case3(subtree);
-  }
-
-  template< class Key, class T, class Compare >
-  void RedBlackTree< Key, T, Compare >::erase_balance_case3(detail::TreeNode< Key, T > * subtree)
-  {
-    using namespace detail;
-    TreeNode< Key, T > * brother = find_brother(subtree);
-    bool is_any_child_black = is_color< BLACK >(brother->left) && is_color< BLACK >(brother->right);
-    if (is_color< BLACK >(subtree->parent) && is_color< BLACK >(brother) && is_any_child_black)
-    {
-      colorize< RED >(brother);
-      erase_balance_case1(subtree->parent);
-    }
-    else
-    {
-      erase_balance_case4(subtree);
-    }
-  }
-
-  template< class Key, class T, class Compare >
-  void RedBlackTree< Key, T, Compare >::erase_balance_case4(detail::TreeNode< Key, T > * subtree)
-  {
-    using namespace detail;
-    TreeNode< Key, T > * brother = find_brother(subtree);
-    bool is_any_child_black = is_color< BLACK >(brother->left) && is_color< BLACK >(brother->right);
-    if (is_color< RED >(subtree->parent) && is_color< BLACK >(brother) && is_any_child_black)
-    {
-      colorize< RED >(brother);
-      colorize< BLACK >(subtree->parent);
-    }
-    else
-    {
-      erase_balance_case5(subtree);
-    }
-  }
-
-  template< class Key, class T, class Compare >
-  void RedBlackTree< Key, T, Compare >::erase_balance_case5(detail::TreeNode< Key, T > * subtree)
-  {
-    using namespace detail;
-    TreeNode< Key, T > * brother = find_brother(subtree);
-    if (is_color< BLACK >(brother))
-    {
-      if (subtree == subtree->parent->left && is_color< BLACK >(brother->right) && is_color< RED >(brother->left))
-      {
-        colorize< RED >(brother);
-        colorize< BLACK >(brother->left);
-        rotate_right(brother);
-      }
-      else if (subtree == subtree->parent->right && is_color< RED >(brother->right) && is_color< BLACK >(brother->left))
-      {
-        colorize< RED >(brother);
-        colorize< BLACK >(brother->right);
-        rotate_left(brother);
+        TreeNode< Key, T > * brother = parent->left;
+        if (is_color< RED >(brother))
+        {
+          colorize< BLACK >(brother);
+          colorize< RED >(parent);
+          rotate_right(parent);
+          brother = parent->left;
+        }
+        if (is_color< BLACK >(brother->left) && is_color< BLACK >(brother->right))
+        {
+          colorize< RED >(brother);
+          subtree = parent;
+          parent = subtree->parent;
+        }
+        else
+        {
+          if (is_color< BLACK >(brother->left))
+          {
+            colorize< BLACK >(brother->right);
+            colorize< RED >(brother);
+            rotate_left(brother);
+            brother = parent->left;
+          }
+          brother->color = parent->color;
+          colorize< BLACK >(parent);
+          colorize< BLACK >(brother->left);
+          rotate_right(parent);
+          subtree = root_;
+        }
       }
     }
-    erase_balance_case6(subtree);
-  }
-
-  template< class Key, class T, class Compare >
-  void RedBlackTree< Key, T, Compare >::erase_balance_case6(detail::TreeNode< Key, T > * subtree)
-  {
-    using namespace detail;
-    TreeNode< Key, T > * brother = find_brother(subtree);
-    brother->color = subtree->parent->color;
-    colorize< BLACK >(subtree->parent);
-    if (subtree == subtree->parent->left)
-    {
-      colorize< BLACK >(brother->right);
-      rotate_left(subtree->parent);
-    }
-    else
+    if (subtree)
     {
-      colorize< BLACK >(brother->left);
-      rotate_right(subtree->parent);
+      colorize< BLACK >(subtree);
     }
   }
 }
@@ -9,7 +9,7 @@
 
 namespace erohin
 {
-  template < class Key, class T, class Compare >
+  template < class Key, class T, class Compare, class Allocator, class Augment >
   class RedBlackTree;
 
   template < class Key, class T >
@@ -24,7 +24,7 @@ namespace erohin
   template< class Key, class T >
   class TreeConstIterator: public std::iterator< std::bidirectional_iterator_tag, const std::pair< Key, T > >
   {
-    template < class T1, class T2, class T3 >
+    template < class T1, class T2, class T3, class T4, class T5 >
     friend class RedBlackTree;
 
     template < class T1, class T2 >
@@ -27,6 +27,7 @@ namespace erohin
       ~TreeNode() = default;
       TreeNode * next();
       TreeNode * prev();
+      TreeNode * root();
     };
 
     template< class Key, class T >
@@ -39,6 +40,54 @@ namespace erohin
       color(color_t::RED)
     {}
 
+    struct NoAugment
+    {
+      struct value_type
+      {};
+    };
+
+    template< class Key, class T, class Augment >
+    struct AugmentedTreeNode: TreeNode< Key, T >
+    {
+      typename Augment::value_type aggregate;
+      template< class... Args >
+      AugmentedTreeNode(TreeNode< Key, T > * parent_node, TreeNode< Key, T > * left_node, TreeNode< Key, T > * right_node, Args &&... args);
+    };
+
+    template< class Key, class T >
+    struct AugmentedTreeNode< Key, T, NoAugment >: TreeNode< Key, T >
+    {
+      using TreeNode< Key, T >::TreeNode;
+    };
+
+    template< class Key, class T, class Augment >
+    template< class... Args >
+    AugmentedTreeNode< Key, T, Augment >::AugmentedTreeNode(TreeNode< Key, T > * parent_node, TreeNode< Key, T > * left_node,
+      TreeNode< Key, T > * right_node, Args &&... args):
+      TreeNode< Key, T >(parent_node, left_node, right_node, std::forward< Args >(args)...),
+      aggregate(Augment::make(this->data))
+    {}
+
+    template< class Key, class T, class Augment >
+    void refreshAggregate(TreeNode< Key, T > * node, Augment)
+    {
+      using node_type = AugmentedTreeNode< Key, T, Augment >;
+      typename Augment::value_type result = Augment::make(node->data);
+      if (node->left)
+      {
+        result = Augment::combine(static_cast< node_type * >(node->left)->aggregate, result);
+      }
+      if (node->right)
+      {
+        result = Augment::combine(result, static_cast< node_type * >(node->right)->aggregate);
+      }
+      static_cast< node_type * >(node)->aggregate = result;
+    }
+
+    template< class Key, class T >
+    void refreshAggregate(TreeNode< Key, T > *, NoAugment)
+    {}
+
     template< class Key, class T >
     TreeNode< Key, T > * TreeNode< Key, T >::next()
     {
@@ -92,6 +141,17 @@ namespace erohin
       }
       return node;
     }
+
+    template< class Key, class T >
+    TreeNode< Key, T > * TreeNode< Key, T >::root()
+    {
+      TreeNode< Key, T > * node = this;
+      while (node->parent)
+      {
+        node = node->parent;
+      }
+      return node;
+    }
   }
 }
 
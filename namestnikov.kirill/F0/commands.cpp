@@ -7,8 +7,10 @@
 #include <functional>
 #include <vector>
 #include <bidirectional_list.hpp>
-#include <hash_table.hpp>
+#include <flat_hash_table.hpp>
 #include "delimeters.hpp"
+#include "dictionary.hpp"
+#include "input_output_data.hpp"
 
 void namestnikov::doHelp(std::ostream & out)
 {
@@ -26,13 +28,6 @@ void namestnikov::doHelp(std::ostream & out)
   out << "suffix <newdict> <dict> <suffix> - make a new dictionary with words that has this suffix\n";
 }
 
-bool startsWith(const std::pair< std::string, std::string > & pairDict, const std::string & sub)
-{
-  size_t strLength = pairDict.first.size();
-  size_t subLength = sub.size();
-  return ((strLength >= subLength) && (pairDict.first.compare(0, subLength, sub) == 0));
-}
-
 bool endsWith(const std::pair< std::string, std::string > & pairDict, const std::string & sub)
 {
   size_t strLength = pairDict.first.size();
@@ -49,8 +44,7 @@ void namestnikov::doCreate(std::istream & in, dictMain & mainMap, std::ostream &
     out << "The dictionary with name " << newName << " already exists.\n";
     return;
   }
-  HashTable< std::string, std::string > newDict;
-  mainMap[newName] = newDict;
+  mainMap[newName] = Dictionary();
   out << newName << " is successfully created.\n";
 }
 
@@ -67,12 +61,10 @@ void namestnikov::doAdd(std::istream & in, dictMain & mainMap, std::ostream & ou
     out << "The dictionary with name " << dictName << " doesn't exist.\n";
     return;
   }
-  if (mainMap[dictName].find(key) != mainMap[dictName].end())
+  if (!mainMap[dictName].insert(key, translation))
   {
     out << "The word " << key << " already exists in " << dictName << ".\n";
-    return;
   }
-  mainMap[dictName].insert(key, translation);
 }
 
 void namestnikov::doFind(std::istream & in, dictMain & mainMap, std::ostream & out)
@@ -91,7 +83,7 @@ void namestnikov::doFind(std::istream & in, dictMain & mainMap, std::ostream & o
     out << "The word " << key << " doesn't exist in " << dictName << ".\n";
     return;
   }
-  out << mainMap[dictName][key] << "\n";
+  out << mainMap[dictName].at(key) << "\n";
 }
 
 void namestnikov::doRemove(std::istream & in, dictMain & mainMap, std::ostream & out)
@@ -100,11 +92,10 @@ void namestnikov::doRemove(std::istream & in, dictMain & mainMap, std::ostream &
   in >> dictName;
   std::string key = "";
   in >> key;
-  if (mainMap[dictName].find(key) == mainMap[dictName].end())
+  if (!mainMap[dictName].erase(key))
   {
     throw std::invalid_argument("The word doesn't exist in this dict");
   }
-  mainMap[dictName].erase(mainMap[dictName].find(key));
   out << "The word " << key << " sucessfully deleted from " << dictName << ".\n";
 }
 
@@ -116,9 +107,9 @@ void namestnikov::doSubtract(std::istream & in, dictMain & mainMap, std::ostream
   in >> firstDict;
   std::string secondDict = "";
   in >> secondDict;
-  HashTable< std::string, std::string > res;
-  HashTable< std::string, std::string > first = mainMap.at(firstDict);
-  HashTable< std::string, std::string > second = mainMap.at(secondDict);
+  Dictionary res;
+  const Dictionary & first = mainMap.at(firstDict);
+  const Dictionary & second = mainMap.at(secondDict);
   for (const auto & key1: first)
   {
     if (second.find(key1.first) == second.end())
@@ -126,7 +117,7 @@ void namestnikov::doSubtract(std::istream & in, dictMain & mainMap, std::ostream
       res.insert(key1.first, key1.second);
     }
   }
-  mainMap[resDict] = res;
+  mainMap[resDict] = std::move(res);
   out << "Dictionary " << resDict << " is successfully created.\n";
 }
 
@@ -138,21 +129,19 @@ void namestnikov::doMerge(std::istream & in, dictMain & mainMap, std::ostream &
   in >> firstDict;
   std::string secondDict = "";
   in >> secondDict;
-  HashTable< std::string, std::string > res;
-  HashTable< std::string, std::string > first = mainMap.at(firstDict);
-  HashTable< std::string, std::string > second = mainMap.at(secondDict);
+  const Dictionary & first = mainMap.at(firstDict);
+  const Dictionary & second = mainMap.at(secondDict);
+  Dictionary res;
+  res.reserve(first.size() + second.size());
   for (const auto & key1: first)
   {
     res.insert(key1.first, key1.second);
   }
   for (const auto & key2: second)
   {
-    if (res.find(key2.first) == res.end())
-    {
-      res.insert(key2.first, key2.second);
-    }
+    res.insert(key2.first, key2.second);
   }
-  mainMap[resDict] = res;
+  mainMap[resDict] = std::move(res);
   out << "Dictionary " << resDict << " is successfully created.\n";
 }
 
@@ -172,7 +161,7 @@ void namestnikov::doExport(std::istream & in, const dictMain & mainMap)
     throw std::invalid_argument("Can't open this file");
   }
   outFile << dict << "\n";
-  HashTable< std::string, std::string > res = mainMap.at(dict);
+  const Dictionary & res = mainMap.at(dict);
   for (const auto & pair: res)
   {
     outFile << pair.first << " - " << pair.second << "\n";
@@ -194,9 +183,11 @@ void namestnikov::doImport(std::istream & in, dictMain & mainMap)
   {
     throw std::invalid_argument("Can't open this file");
   }
+  size_t lines = countLines(inFile);
   std::string resDict = "";
   inFile >> resDict;
-  HashTable< std::string, std::string > res;
+  Dictionary res;
+  res.reserve(lines);
   std::string key = "";
   std::string value = "";
   using delC = namestnikov::DelimeterChar;
@@ -204,7 +195,7 @@ void namestnikov::doImport(std::istream & in, dictMain & mainMap)
   {
     res.insert(key, value);
   }
-  mainMap[resDict] = res;
+  mainMap[resDict] = std::move(res);
 }
 
 void namestnikov::doPrefix(std::istream & in, dictMain & mainMap, std::ostream & out)
@@ -213,28 +204,25 @@ void namestnikov::doPrefix(std::istream & in, dictMain & mainMap, std::ostream &
   in >> newDict;
   std::string dict = "";
   in >> dict;
-  HashTable< std::string, std::string > searchDict = mainMap.at(dict);
+  const Dictionary & searchDict = mainMap.at(dict);
   if (searchDict.empty())
   {
     out << dict << " is empty.\n";
     return;
   }
-  HashTable< std::string, std::string > res;
+  Dictionary res;
   std::string prefix = "";
   in >> prefix;
-  for (const auto & key: searchDict)
+  searchDict.forEachWithPrefix(prefix, [& res, & searchDict](const std::string & key)
   {
-    if (startsWith(key, prefix))
-    {
-      res.insert(key.first, key.second);
-    }
-  }
+    res.insert(key, searchDict.at(key));
+  });
   if (res.empty())
   {
     out << "There aren't any words in " << dict << " with prefix " << prefix << ".\n";
     return;
   }
-  mainMap[newDict] = res;
+  mainMap[newDict] = std::move(res);
 }
 
 void namestnikov::doPostfix(std::istream & in, dictMain & mainMap, std::ostream & out)
@@ -243,48 +231,42 @@ void namestnikov::doPostfix(std::istream & in, dictMain & mainMap, std::ostream
   in >> newDict;
   std::string dict = "";
   in >> dict;
-  HashTable< std::string, std::string > searchDict = mainMap.at(dict);
+  const Dictionary & searchDict = mainMap.at(dict);
   if (searchDict.empty())
   {
     out << dict << " is empty.\n";
     return;
   }
-  HashTable< std::string, std::string > res;
+  Dictionary res;
   std::string postfix = "";
   in >> postfix;
-  for (const auto & key: searchDict)
+  searchDict.forEachWithPostfix(postfix, [& res, & searchDict](const std::string & key)
   {
-    if (endsWith(key, postfix))
-    {
-      res.insert(key.first, key.second);
-    }
-  }
+    res.insert(key, searchDict.at(key));
+  });
   if (res.empty())
   {
     out << "There aren't any words in " << dict << " with postfix " << postfix << ".\n";
     return;
   }
-  mainMap[newDict] = res;
+  mainMap[newDict] = std::move(res);
 }
 
-bool hasBetween(const std::pair< std::string, std::string > & pairDict, const std::string & sub)
+bool hasBetween(const std::string & word, const std::string & sub)
 {
-  size_t strLength = pairDict.first.size();
+  size_t strLength = word.size();
   size_t subLength = sub.size();
-  if (pairDict.first == sub)
+  if (word == sub)
   {
     return true;
   }
-  if (strLength < subLength)
+  if (strLength <= subLength)
   {
     return false;
   }
-  bool check = false;
-  for (size_t i = 0; i <= strLength - subLength; ++i)
-  {
-    check = check || (pairDict.first.compare(i, subLength, sub) == 0);
-  }
-  return (check && (!startsWith(pairDict, sub)) && (!endsWith(pairDict, sub)));
+  bool starts = (word.compare(0, subLength, sub) == 0);
+  bool ends = (word.compare(strLength - subLength, subLength, sub) == 0);
+  return ((!starts) && (!ends) && (word.find(sub) != std::string::npos));
 }
 
 void namestnikov::doSuffix(std::istream & in, dictMain & mainMap, std::ostream & out)
@@ -293,28 +275,28 @@ void namestnikov::doSuffix(std::istream & in, dictMain & mainMap, std::ostream &
   in >> newDict;
   std::string dict = "";
   in >> dict;
-  HashTable< std::string, std::string > searchDict = mainMap.at(dict);
+  const Dictionary & searchDict = mainMap.at(dict);
   if (searchDict.empty())
   {
     out << dict << " is empty.\n";
     return;
   }
-  HashTable< std::string, std::string > res;
+  Dictionary res;
   std::string suffix = "";
   in >> suffix;
-  for (const auto & key: searchDict)
+  searchDict.forEachContaining(suffix, [& res, & searchDict, & suffix](const std::string & key)
   {
     if (hasBetween(key, suffix))
     {
-      res.insert(key.first, key.second);
+      res.insert(key, searchDict.at(key));
     }
-  }
+  });
   if (res.empty())
   {
     out << "There aren't any words in " << dict << " with suffix " << suffix << ".\n";
     return;
   }
-  mainMap[newDict] = res;
+  mainMap[newDict] = std::move(res);
 }
 
 void namestnikov::doPalindrome(std::istream & in, dictMain & mainMap, std::ostream & out)
@@ -322,7 +304,7 @@ void namestnikov::doPalindrome(std::istream & in, dictMain & mainMap, std::ostre
   std::string dictName = "";
   in >> dictName;
   List< std::string > palindromes;
-  HashTable< std::string, std::string > searchDict = mainMap.at(dictName);
+  const Dictionary & searchDict = mainMap.at(dictName);
   for (const auto & pair1: searchDict)
   {
     for (const auto & pair2: searchDict)
@@ -2,11 +2,12 @@
 #define COMMANDS_HPP
 
 #include <string>
-#include <hash_table.hpp>
+#include <flat_hash_table.hpp>
+#include "dictionary.hpp"
 
 namespace namestnikov
 {
-  using dictMain = HashTable< std::string, HashTable< std::string, std::string > >;
+  using dictMain = FlatHashTable< std::string, Dictionary >;
   void doHelp(std::ostream & out);
   void doCreate(std::istream & in, dictMain & mainMap, std::ostream & out);
   void doAdd(std::istream & in, dictMain & mainMap, std::ostream & out);
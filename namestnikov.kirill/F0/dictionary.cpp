@@ -0,0 +1,170 @@
+#include "dictionary.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+  std::string reversed(const std::string & str)
+  {
+    return std::string(str.rbegin(), str.rend());
+  }
+}
+
+namestnikov::Dictionary::Dictionary():
+  words_(),
+  prefixes_(),
+  postfixes_(),
+  substrings_(),
+  hasPrefixes_(false),
+  hasPostfixes_(false),
+  hasSubstrings_(false)
+{}
+
+namestnikov::Dictionary::Dictionary(const Dictionary & other):
+  words_(other.words_),
+  prefixes_(),
+  postfixes_(),
+  substrings_(),
+  hasPrefixes_(false),
+  hasPostfixes_(false),
+  hasSubstrings_(false)
+{}
+
+namestnikov::Dictionary & namestnikov::Dictionary::operator=(const Dictionary & other)
+{
+  if (this != std::addressof(other))
+  {
+    Dictionary temp(other);
+    std::swap(*this, temp);
+  }
+  return *this;
+}
+
+bool namestnikov::Dictionary::insert(const std::string & key, const std::string & value)
+{
+  if (!words_.insert(key, value).second)
+  {
+    return false;
+  }
+  if (hasPrefixes_)
+  {
+    prefixes_.insert(key);
+  }
+  if (hasPostfixes_)
+  {
+    postfixes_.insert(reversed(key));
+  }
+  dropSubstrings();
+  return true;
+}
+
+bool namestnikov::Dictionary::erase(const std::string & key)
+{
+  if (!words_.erase(key))
+  {
+    return false;
+  }
+  if (hasPrefixes_)
+  {
+    prefixes_.erase(key);
+  }
+  if (hasPostfixes_)
+  {
+    postfixes_.erase(reversed(key));
+  }
+  dropSubstrings();
+  return true;
+}
+
+void namestnikov::Dictionary::reserve(size_t count)
+{
+  words_.reserve(count);
+}
+
+const std::string & namestnikov::Dictionary::at(const std::string & key) const
+{
+  return words_.at(key);
+}
+
+namestnikov::Dictionary::const_iterator namestnikov::Dictionary::find(const std::string & key) const
+{
+  return words_.find(key);
+}
+
+namestnikov::Dictionary::const_iterator namestnikov::Dictionary::begin() const
+{
+  return words_.cbegin();
+}
+
+namestnikov::Dictionary::const_iterator namestnikov::Dictionary::end() const
+{
+  return words_.cend();
+}
+
+size_t namestnikov::Dictionary::size() const noexcept
+{
+  return words_.size();
+}
+
+bool namestnikov::Dictionary::empty() const noexcept
+{
+  return words_.empty();
+}
+
+void namestnikov::Dictionary::forEachWithPrefix(const std::string & prefix, const visitor_t & visit) const
+{
+  if (!hasPrefixes_)
+  {
+    RadixTrie trie;
+    for (const auto & pair: words_)
+    {
+      trie.insert(pair.first);
+    }
+    prefixes_ = std::move(trie);
+    hasPrefixes_ = true;
+  }
+  prefixes_.forEachWithPrefix(prefix, visit);
+}
+
+void namestnikov::Dictionary::forEachWithPostfix(const std::string & postfix, const visitor_t & visit) const
+{
+  if (!hasPostfixes_)
+  {
+    RadixTrie trie;
+    for (const auto & pair: words_)
+    {
+      trie.insert(reversed(pair.first));
+    }
+    postfixes_ = std::move(trie);
+    hasPostfixes_ = true;
+  }
+  postfixes_.forEachWithPrefix(reversed(postfix), [& visit](const std::string & key)
+  {
+    visit(reversed(key));
+  });
+}
+
+void namestnikov::Dictionary::forEachContaining(const std::string & pattern, const visitor_t & visit) const
+{
+  if (!hasSubstrings_)
+  {
+    SuffixArray suffixes;
+    for (const auto & pair: words_)
+    {
+      suffixes.insert(pair.first);
+    }
+    suffixes.build();
+    substrings_ = std::move(suffixes);
+    hasSubstrings_ = true;
+  }
+  substrings_.forEachContaining(pattern, visit);
+}
+
+void namestnikov::Dictionary::dropSubstrings() noexcept
+{
+  if (hasSubstrings_)
+  {
+    substrings_ = SuffixArray();
+    hasSubstrings_ = false;
+  }
+}
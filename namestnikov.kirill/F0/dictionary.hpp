@@ -0,0 +1,49 @@
+#ifndef DICTIONARY_HPP
+#define DICTIONARY_HPP
+
+#include <cstddef>
+#include <string>
+#include <flat_hash_table.hpp>
+#include "radix_trie.hpp"
+#include "suffix_array.hpp"
+
+namespace namestnikov
+{
+  class Dictionary
+  {
+  public:
+    using table_t = FlatHashTable< std::string, std::string >;
+    using const_iterator = table_t::const_flat_hash_table_iterator;
+    using visitor_t = RadixTrie::visitor_t;
+    Dictionary();
+    Dictionary(const Dictionary & other);
+    Dictionary(Dictionary &&) noexcept = default;
+    Dictionary & operator=(const Dictionary & other);
+    Dictionary & operator=(Dictionary &&) noexcept = default;
+    ~Dictionary() = default;
+
+    bool insert(const std::string & key, const std::string & value);
+    bool erase(const std::string & key);
+    void reserve(size_t count);
+    const std::string & at(const std::string & key) const;
+    const_iterator find(const std::string & key) const;
+    const_iterator begin() const;
+    const_iterator end() const;
+    size_t size() const noexcept;
+    bool empty() const noexcept;
+    void forEachWithPrefix(const std::string & prefix, const visitor_t & visit) const;
+    void forEachWithPostfix(const std::string & postfix, const visitor_t & visit) const;
+    void forEachContaining(const std::string & pattern, const visitor_t & visit) const;
+  private:
+    table_t words_;
+    mutable RadixTrie prefixes_;
+    mutable RadixTrie postfixes_;
+    mutable SuffixArray substrings_;
+    mutable bool hasPrefixes_;
+    mutable bool hasPostfixes_;
+    mutable bool hasSubstrings_;
+    void dropSubstrings() noexcept;
+  };
+}
+
+#endif
@@ -1,12 +1,25 @@
 #include "input_output_data.hpp"
+#include <algorithm>
+#include <iterator>
 #include <stdexcept>
 #include "delimeters.hpp"
 
-namestnikov::HashTable< std::string, std::string > namestnikov::inputDict(std::ifstream & in)
+size_t namestnikov::countLines(std::ifstream & in)
 {
+  using input_it_t = std::istreambuf_iterator< char >;
+  size_t lines = std::count(input_it_t(in), input_it_t(), '\n');
+  in.clear();
+  in.seekg(0);
+  return lines;
+}
+
+namestnikov::Dictionary namestnikov::inputDict(std::ifstream & in)
+{
+  size_t lines = countLines(in);
   std::string key = "";
   std::string value = "";
-  HashTable< std::string, std::string > res;
+  Dictionary res;
+  res.reserve(lines);
   using delC = DelimeterChar;
   while (in >> key >> delC{'-'} >> value)
   {
@@ -19,7 +32,7 @@ namestnikov::HashTable< std::string, std::string > namestnikov::inputDict(std::i
   return res;
 }
 
-void namestnikov::outputDict(std::ofstream & out, const HashTable< std::string, std::string > & dict)
+void namestnikov::outputDict(std::ofstream & out, const Dictionary & dict)
 {
   for (const auto & pair: dict)
   {
@@ -2,12 +2,13 @@
 #define INPUT_OUTPUT_DATA_HPP
 
 #include <fstream>
-#include <hash_table.hpp>
+#include "dictionary.hpp"
 
 namespace namestnikov
 {
-  HashTable< std::string, std::string > inputDict(std::ifstream & in);
-  void outputDict(std::ofstream & out, const HashTable< std::string, std::string > & dict);
+  size_t countLines(std::ifstream & in);
+  Dictionary inputDict(std::ifstream & in);
+  void outputDict(std::ofstream & out, const Dictionary & dict);
 }
 
 #endif
@@ -3,6 +3,7 @@
 #include <limits>
 #include <string>
 #include <functional>
+#include <utility>
 #include "delimeters.hpp"
 #include "commands.hpp"
 #include "input_output_data.hpp"
@@ -10,7 +11,7 @@
 int main(int argc, char * argv[])
 {
   using namespace namestnikov;
-  using dictMain = HashTable< std::string, HashTable< std::string, std::string > >;
+  using dictMain = FlatHashTable< std::string, Dictionary >;
   dictMain myMap;
   try
   {
@@ -29,8 +30,8 @@ int main(int argc, char * argv[])
           std::cerr << "Cannot open file\n";
           return 1;
         }
-        HashTable< std::string, std::string > res = inputDict(inFile);
-        myMap[argv[i]] = res;
+        Dictionary res = inputDict(inFile);
+        myMap[argv[i]] = std::move(res);
       }
     }
   }
@@ -39,7 +40,7 @@ int main(int argc, char * argv[])
     std::cerr << "Error while trying to read dicts\n";
     return 1;
   }
-  HashTable< std::string, std::function< void(std::istream &) > > commands;
+  FlatHashTable< std::string, std::function< void(std::istream &) > > commands;
   {
     using namespace std::placeholders;
     commands["add"] = std::bind(doAdd, _1, std::ref(myMap), std::ref(std::cout));
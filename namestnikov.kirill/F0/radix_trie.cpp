@@ -0,0 +1,197 @@
+#include "radix_trie.hpp"
+#include <algorithm>
+#include <utility>
+
+namestnikov::RadixTrie::RadixTrie():
+  nodes_(1, Node{ "", {}, false }),
+  free_(),
+  size_(0)
+{}
+
+bool namestnikov::RadixTrie::insert(const std::string & key)
+{
+  size_t node = 0;
+  size_t pos = 0;
+  while (pos < key.size())
+  {
+    size_t index = findChild(node, key[pos]);
+    if (index == nodes_[node].children.size())
+    {
+      size_t leaf = newNode(key.substr(pos), true);
+      std::vector< size_t > & children = nodes_[node].children;
+      auto it = std::lower_bound(children.begin(), children.end(), key[pos],
+        [this](size_t child, char first)
+        {
+          return nodes_[child].label[0] < first;
+        });
+      children.insert(it, leaf);
+      ++size_;
+      return true;
+    }
+    size_t child = nodes_[node].children[index];
+    const std::string & label = nodes_[child].label;
+    size_t common = 0;
+    while ((common < label.size()) && (pos + common < key.size()) && (label[common] == key[pos + common]))
+    {
+      ++common;
+    }
+    if (common < label.size())
+    {
+      size_t middle = newNode(nodes_[child].label.substr(0, common), false);
+      nodes_[child].label.erase(0, common);
+      nodes_[middle].children.push_back(child);
+      nodes_[node].children[index] = middle;
+      child = middle;
+    }
+    node = child;
+    pos += common;
+  }
+  if (nodes_[node].isKey)
+  {
+    return false;
+  }
+  nodes_[node].isKey = true;
+  ++size_;
+  return true;
+}
+
+bool namestnikov::RadixTrie::erase(const std::string & key)
+{
+  size_t parent = 0;
+  size_t node = 0;
+  size_t pos = 0;
+  while (pos < key.size())
+  {
+    size_t index = findChild(node, key[pos]);
+    if (index == nodes_[node].children.size())
+    {
+      return false;
+    }
+    size_t child = nodes_[node].children[index];
+    const std::string & label = nodes_[child].label;
+    if (key.compare(pos, label.size(), label) != 0)
+    {
+      return false;
+    }
+    parent = node;
+    node = child;
+    pos += label.size();
+  }
+  if (!nodes_[node].isKey)
+  {
+    return false;
+  }
+  nodes_[node].isKey = false;
+  --size_;
+  if (node == 0)
+  {
+    return true;
+  }
+  if (nodes_[node].children.empty())
+  {
+    std::vector< size_t > & siblings = nodes_[parent].children;
+    siblings.erase(std::find(siblings.begin(), siblings.end(), node));
+    freeNode(node);
+    if ((parent != 0) && !nodes_[parent].isKey && (nodes_[parent].children.size() == 1))
+    {
+      mergeWithChild(parent);
+    }
+  }
+  else if (nodes_[node].children.size() == 1)
+  {
+    mergeWithChild(node);
+  }
+  return true;
+}
+
+void namestnikov::RadixTrie::forEachWithPrefix(const std::string & prefix, const visitor_t & visit) const
+{
+  size_t node = 0;
+  size_t pos = 0;
+  std::string path = "";
+  while (pos < prefix.size())
+  {
+    size_t index = findChild(node, prefix[pos]);
+    if (index == nodes_[node].children.size())
+    {
+      return;
+    }
+    size_t child = nodes_[node].children[index];
+    const std::string & label = nodes_[child].label;
+    size_t length = std::min(label.size(), prefix.size() - pos);
+    if (label.compare(0, length, prefix, pos, length) != 0)
+    {
+      return;
+    }
+    path += label;
+    node = child;
+    pos += label.size();
+  }
+  visitAll(node, path, visit);
+}
+
+size_t namestnikov::RadixTrie::size() const noexcept
+{
+  return size_;
+}
+
+size_t namestnikov::RadixTrie::newNode(const std::string & label, bool isKey)
+{
+  if (free_.empty())
+  {
+    nodes_.push_back(Node{ label, {}, isKey });
+    return nodes_.size() - 1;
+  }
+  size_t node = free_.back();
+  free_.pop_back();
+  nodes_[node].label = label;
+  nodes_[node].isKey = isKey;
+  return node;
+}
+
+void namestnikov::RadixTrie::freeNode(size_t node)
+{
+  std::string().swap(nodes_[node].label);
+  std::vector< size_t >().swap(nodes_[node].children);
+  nodes_[node].isKey = false;
+  free_.push_back(node);
+}
+
+size_t namestnikov::RadixTrie::findChild(size_t node, char first) const
+{
+  const std::vector< size_t > & children = nodes_[node].children;
+  auto it = std::lower_bound(children.begin(), children.end(), first,
+    [this](size_t child, char value)
+    {
+      return nodes_[child].label[0] < value;
+    });
+  if ((it != children.end()) && (nodes_[*it].label[0] == first))
+  {
+    return it - children.begin();
+  }
+  return children.size();
+}
+
+void namestnikov::RadixTrie::mergeWithChild(size_t node)
+{
+  size_t child = nodes_[node].children.front();
+  nodes_[node].label += nodes_[child].label;
+  nodes_[node].isKey = nodes_[child].isKey;
+  nodes_[node].children = std::move(nodes_[child].children);
+  freeNode(child);
+}
+
+void namestnikov::RadixTrie::visitAll(size_t node, std::string & path, const visitor_t & visit) const
+{
+  if (nodes_[node].isKey)
+  {
+    visit(path);
+  }
+  for (size_t child: nodes_[node].children)
+  {
+    size_t length = path.size();
+    path += nodes_[child].label;
+    visitAll(child, path, visit);
+    path.resize(length);
+  }
+}
@@ -0,0 +1,38 @@
+#ifndef RADIX_TRIE_HPP
+#define RADIX_TRIE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace namestnikov
+{
+  class RadixTrie
+  {
+  public:
+    using visitor_t = std::function< void(const std::string &) >;
+    RadixTrie();
+    bool insert(const std::string & key);
+    bool erase(const std::string & key);
+    void forEachWithPrefix(const std::string & prefix, const visitor_t & visit) const;
+    size_t size() const noexcept;
+  private:
+    struct Node
+    {
+      std::string label;
+      std::vector< size_t > children;
+      bool isKey;
+    };
+    std::vector< Node > nodes_;
+    std::vector< size_t > free_;
+    size_t size_;
+    size_t newNode(const std::string & label, bool isKey);
+    void freeNode(size_t node);
+    size_t findChild(size_t node, char first) const;
+    void mergeWithChild(size_t node);
+    void visitAll(size_t node, std::string & path, const visitor_t & visit) const;
+  };
+}
+
+#endif
@@ -0,0 +1,266 @@
+#include "suffix_array.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+  int toSymbol(char c)
+  {
+    return static_cast< unsigned char >(c) + 1;
+  }
+
+  std::vector< int > induceSuffixArray(const std::vector< int > & s, int upper)
+  {
+    int n = static_cast< int >(s.size());
+    if (n == 0)
+    {
+      return {};
+    }
+    if (n == 1)
+    {
+      return { 0 };
+    }
+    if (n == 2)
+    {
+      return (s[0] < s[1]) ? std::vector< int >{ 0, 1 } : std::vector< int >{ 1, 0 };
+    }
+    std::vector< int > sa(n);
+    std::vector< bool > isS(n);
+    for (int i = n - 2; i >= 0; --i)
+    {
+      isS[i] = (s[i] == s[i + 1]) ? isS[i + 1] : (s[i] < s[i + 1]);
+    }
+    std::vector< int > sumL(upper + 1);
+    std::vector< int > sumS(upper + 1);
+    for (int i = 0; i < n; ++i)
+    {
+      if (!isS[i])
+      {
+        ++sumS[s[i]];
+      }
+      else
+      {
+        ++sumL[s[i] + 1];
+      }
+    }
+    for (int i = 0; i <= upper; ++i)
+    {
+      sumS[i] += sumL[i];
+      if (i < upper)
+      {
+        sumL[i + 1] += sumS[i];
+      }
+    }
+    auto induce = [&](const std::vector< int > & lms)
+    {
+      std::fill(sa.begin(), sa.end(), -1);
+      std::vector< int > buf(sumS);
+      for (int d: lms)
+      {
+        if (d != n)
+        {
+          sa[buf[s[d]]++] = d;
+        }
+      }
+      buf = sumL;
+      sa[buf[s[n - 1]]++] = n - 1;
+      for (int i = 0; i < n; ++i)
+      {
+        int v = sa[i];
+        if ((v >= 1) && !isS[v - 1])
+        {
+          sa[buf[s[v - 1]]++] = v - 1;
+        }
+      }
+      buf = sumL;
+      for (int i = n - 1; i >= 0; --i)
+      {
+        int v = sa[i];
+        if ((v >= 1) && isS[v - 1])
+        {
+          sa[--buf[s[v - 1] + 1]] = v - 1;
+        }
+      }
+    };
+    std::vector< int > lmsMap(n + 1, -1);
+    std::vector< int > lms;
+    for (int i = 1; i < n; ++i)
+    {
+      if (!isS[i - 1] && isS[i])
+      {
+        lmsMap[i] = static_cast< int >(lms.size());
+        lms.push_back(i);
+      }
+    }
+    int m = static_cast< int >(lms.size());
+    induce(lms);
+    if (m != 0)
+    {
+      std::vector< int > sortedLms;
+      sortedLms.reserve(m);
+      for (int v: sa)
+      {
+        if (lmsMap[v] != -1)
+        {
+          sortedLms.push_back(v);
+        }
+      }
+      std::vector< int > reduced(m);
+      int reducedUpper = 0;
+      reduced[lmsMap[sortedLms[0]]] = 0;
+      for (int i = 1; i < m; ++i)
+      {
+        int l = sortedLms[i - 1];
+        int r = sortedLms[i];
+        int endL = (lmsMap[l] + 1 < m) ? lms[lmsMap[l] + 1] : n;
+        int endR = (lmsMap[r] + 1 < m) ? lms[lmsMap[r] + 1] : n;
+        bool same = true;
+        if (endL - l != endR - r)
+        {
+          same = false;
+        }
+        else
+        {
+          while ((l < endL) && (s[l] == s[r]))
+          {
+            ++l;
+            ++r;
+          }
+          if ((l == n) || (s[l] != s[r]))
+          {
+            same = false;
+          }
+        }
+        if (!same)
+        {
+          ++reducedUpper;
+        }
+        reduced[lmsMap[sortedLms[i]]] = reducedUpper;
+      }
+      std::vector< int > reducedSa = induceSuffixArray(reduced, reducedUpper);
+      for (int i = 0; i < m; ++i)
+      {
+        sortedLms[i] = lms[reducedSa[i]];
+      }
+      induce(sortedLms);
+    }
+    return sa;
+  }
+
+  std::vector< int > buildLcp(const std::vector< int > & s, const std::vector< int > & sa)
+  {
+    int n = static_cast< int >(s.size());
+    std::vector< int > rank(n);
+    for (int i = 0; i < n; ++i)
+    {
+      rank[sa[i]] = i;
+    }
+    std::vector< int > lcp(std::max(n - 1, 0));
+    int h = 0;
+    for (int i = 0; i < n; ++i)
+    {
+      if (h > 0)
+      {
+        --h;
+      }
+      if (rank[i] == 0)
+      {
+        continue;
+      }
+      int j = sa[rank[i] - 1];
+      while ((j + h < n) && (i + h < n) && (s[j + h] == s[i + h]))
+      {
+        ++h;
+      }
+      lcp[rank[i] - 1] = h;
+    }
+    return lcp;
+  }
+}
+
+namestnikov::SuffixArray::SuffixArray():
+  text_(),
+  starts_(),
+  owners_(),
+  suffixes_(),
+  lcp_()
+{}
+
+void namestnikov::SuffixArray::insert(const std::string & word)
+{
+  if (text_.size() + word.size() + 1 > static_cast< size_t >(std::numeric_limits< int >::max()))
+  {
+    throw std::length_error("Too much text for suffix array");
+  }
+  int owner = static_cast< int >(starts_.size());
+  starts_.push_back(static_cast< int >(text_.size()));
+  for (char c: word)
+  {
+    text_.push_back(toSymbol(c));
+    owners_.push_back(owner);
+  }
+  text_.push_back(0);
+  owners_.push_back(owner);
+}
+
+void namestnikov::SuffixArray::build()
+{
+  suffixes_ = induceSuffixArray(text_, std::numeric_limits< unsigned char >::max() + 1);
+  lcp_ = buildLcp(text_, suffixes_);
+}
+
+void namestnikov::SuffixArray::forEachContaining(const std::string & pattern, const visitor_t & visit) const
+{
+  if (pattern.empty())
+  {
+    return;
+  }
+  auto first = std::lower_bound(suffixes_.begin(), suffixes_.end(), pattern,
+    [this](int suffix, const std::string & value)
+    {
+      return compareWith(suffix, value) < 0;
+    });
+  if ((first == suffixes_.end()) || (compareWith(*first, pattern) != 0))
+  {
+    return;
+  }
+  int length = static_cast< int >(pattern.size());
+  std::vector< int > owners;
+  owners.push_back(owners_[*first]);
+  for (size_t i = first - suffixes_.begin(); (i < lcp_.size()) && (lcp_[i] >= length); ++i)
+  {
+    owners.push_back(owners_[suffixes_[i + 1]]);
+  }
+  std::sort(owners.begin(), owners.end());
+  owners.erase(std::unique(owners.begin(), owners.end()), owners.end());
+  std::string word = "";
+  for (int owner: owners)
+  {
+    word.clear();
+    for (int i = starts_[owner]; text_[i] != 0; ++i)
+    {
+      word.push_back(static_cast< char >(text_[i] - 1));
+    }
+    visit(word);
+  }
+}
+
+size_t namestnikov::SuffixArray::size() const noexcept
+{
+  return starts_.size();
+}
+
+int namestnikov::SuffixArray::compareWith(int suffix, const std::string & pattern) const
+{
+  for (size_t i = 0; i < pattern.size(); ++i)
+  {
+    int symbol = toSymbol(pattern[i]);
+    int current = text_[suffix + i];
+    if (current != symbol)
+    {
+      return (current < symbol) ? -1 : 1;
+    }
+  }
+  return 0;
+}
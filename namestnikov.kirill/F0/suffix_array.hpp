@@ -0,0 +1,30 @@
+#ifndef SUFFIX_ARRAY_HPP
+#define SUFFIX_ARRAY_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace namestnikov
+{
+  class SuffixArray
+  {
+  public:
+    using visitor_t = std::function< void(const std::string &) >;
+    SuffixArray();
+    void insert(const std::string & word);
+    void build();
+    void forEachContaining(const std::string & pattern, const visitor_t & visit) const;
+    size_t size() const noexcept;
+  private:
+    std::vector< int > text_;
+    std::vector< int > starts_;
+    std::vector< int > owners_;
+    std::vector< int > suffixes_;
+    std::vector< int > lcp_;
+    int compareWith(int suffix, const std::string & pattern) const;
+  };
+}
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef CONST_FLAT_HASH_TABLE_ITERATORS_HPP
+#define CONST_FLAT_HASH_TABLE_ITERATORS_HPP
+
+#include <iterator>
+#include <utility>
+#include <flat_hash_table_control.hpp>
+#include <flat_hash_table_iterators.hpp>
+
+namespace namestnikov
+{
+  template< class Key, class Value >
+  class FlatHashTable;
+
+  template< class Key, class Value >
+  class ConstFlatHashTableIterator: public std::iterator< std::forward_iterator_tag, std::pair< const Key, Value > >
+  {
+    friend class FlatHashTable< Key, Value >;
+  public:
+    using val_type_t = std::pair< const Key, Value >;
+    using flat_hash_table_iterator = FlatHashTableIterator< Key, Value >;
+    using const_flat_hash_table_iterator = ConstFlatHashTableIterator< Key, Value >;
+    ConstFlatHashTableIterator(const flat_hash_table_iterator & other):
+      control_(other.control_),
+      slot_(other.slot_),
+      nextControl_(other.nextControl_),
+      nextSlot_(other.nextSlot_)
+    {}
+    ConstFlatHashTableIterator(const const_flat_hash_table_iterator &) = default;
+    const_flat_hash_table_iterator & operator=(const const_flat_hash_table_iterator &) = default;
+    ConstFlatHashTableIterator(const_flat_hash_table_iterator &&) = default;
+    ~ConstFlatHashTableIterator() = default;
+
+    bool operator==(const const_flat_hash_table_iterator & other) const
+    {
+      return control_ == other.control_;
+    }
+    bool operator!=(const const_flat_hash_table_iterator & other) const
+    {
+      return !(*this == other);
+    }
+    const val_type_t & operator*() const
+    {
+      return *slot_;
+    }
+    const val_type_t * operator->() const
+    {
+      return slot_;
+    }
+    const_flat_hash_table_iterator & operator++()
+    {
+      ++control_;
+      ++slot_;
+      skipFree();
+      return *this;
+    }
+    const_flat_hash_table_iterator operator++(int)
+    {
+      const_flat_hash_table_iterator temp(*this);
+      ++(*this);
+      return temp;
+    }
+  private:
+    const detail::control_t * control_;
+    const val_type_t * slot_;
+    const detail::control_t * nextControl_;
+    const val_type_t * nextSlot_;
+    ConstFlatHashTableIterator(const detail::control_t * control, const val_type_t * slot):
+      ConstFlatHashTableIterator(control, slot, nullptr, nullptr)
+    {}
+    ConstFlatHashTableIterator(const detail::control_t * control, const val_type_t * slot,
+      const detail::control_t * nextControl, const val_type_t * nextSlot):
+      control_(control),
+      slot_(slot),
+      nextControl_(nextControl),
+      nextSlot_(nextSlot)
+    {}
+    void skipFree()
+    {
+      while (*control_ < detail::controlSentinel)
+      {
+        ++control_;
+        ++slot_;
+      }
+      if ((*control_ == detail::controlSentinel) && (nextControl_ != nullptr))
+      {
+        control_ = nextControl_;
+        slot_ = nextSlot_;
+        nextControl_ = nullptr;
+        nextSlot_ = nullptr;
+        skipFree();
+      }
+    }
+  };
+}
+
+#endif
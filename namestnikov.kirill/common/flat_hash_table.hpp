@@ -0,0 +1,527 @@
+#ifndef FLAT_HASH_TABLE_HPP
+#define FLAT_HASH_TABLE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <flat_hash_table_control.hpp>
+#include <flat_hash_table_iterators.hpp>
+#include <const_flat_hash_table_iterators.hpp>
+
+namespace namestnikov
+{
+  template< class Key, class Value >
+  class FlatHashTable
+  {
+  public:
+    using val_type_t = std::pair< const Key, Value >;
+    using control_t = detail::control_t;
+    using flat_hash_table_iterator = FlatHashTableIterator< Key, Value >;
+    using const_flat_hash_table_iterator = ConstFlatHashTableIterator< Key, Value >;
+
+    FlatHashTable() noexcept:
+      capacity_(0),
+      count_(0),
+      deleted_(0),
+      maxLoadFactor_(0.75f),
+      growthLimit_(0),
+      controls_(emptyControls()),
+      slots_(nullptr),
+      oldCapacity_(0),
+      oldControls_(nullptr),
+      oldSlots_(nullptr),
+      migrated_(0),
+      migrationStep_(0)
+    {}
+    explicit FlatHashTable(size_t bucketCount):
+      FlatHashTable()
+    {
+      if (bucketCount == 0)
+      {
+        return;
+      }
+      size_t capacity = 8;
+      while (capacity < bucketCount)
+      {
+        capacity *= 2;
+      }
+      allocate(capacity, controls_, slots_);
+      capacity_ = capacity;
+      growthLimit_ = limitFor(capacity_);
+    }
+    FlatHashTable(const FlatHashTable< Key, Value > & other):
+      FlatHashTable()
+    {
+      maxLoadFactor_ = other.maxLoadFactor_;
+      if (other.capacity_ == 0)
+      {
+        return;
+      }
+      allocate(other.capacity_, controls_, slots_);
+      capacity_ = other.capacity_;
+      growthLimit_ = other.growthLimit_;
+      for (size_t i = 0; i < capacity_; ++i)
+      {
+        if (detail::isFull(other.controls_[i]))
+        {
+          new (slots_ + i) val_type_t(other.slots_[i]);
+          controls_[i] = other.controls_[i];
+          ++count_;
+        }
+        else if (other.controls_[i] == detail::controlDeleted)
+        {
+          controls_[i] = detail::controlDeleted;
+          ++deleted_;
+        }
+      }
+      for (size_t i = other.migrated_; i < other.oldCapacity_; ++i)
+      {
+        if (detail::isFull(other.oldControls_[i]))
+        {
+          construct(hashOf(other.oldSlots_[i].first), other.oldSlots_[i]);
+          ++count_;
+        }
+      }
+    }
+    FlatHashTable< Key, Value > & operator=(const FlatHashTable< Key, Value > & other)
+    {
+      if (this != std::addressof(other))
+      {
+        FlatHashTable< Key, Value > temp(other);
+        swap(temp);
+      }
+      return *this;
+    }
+    FlatHashTable(FlatHashTable< Key, Value > && other) noexcept:
+      FlatHashTable()
+    {
+      swap(other);
+    }
+    FlatHashTable< Key, Value > & operator=(FlatHashTable< Key, Value > && other) noexcept
+    {
+      if (this != std::addressof(other))
+      {
+        FlatHashTable< Key, Value > temp(std::move(other));
+        swap(temp);
+      }
+      return *this;
+    }
+    void swap(FlatHashTable< Key, Value > & other) noexcept
+    {
+      std::swap(capacity_, other.capacity_);
+      std::swap(count_, other.count_);
+      std::swap(deleted_, other.deleted_);
+      std::swap(maxLoadFactor_, other.maxLoadFactor_);
+      std::swap(growthLimit_, other.growthLimit_);
+      std::swap(controls_, other.controls_);
+      std::swap(slots_, other.slots_);
+      std::swap(oldCapacity_, other.oldCapacity_);
+      std::swap(oldControls_, other.oldControls_);
+      std::swap(oldSlots_, other.oldSlots_);
+      std::swap(migrated_, other.migrated_);
+      std::swap(migrationStep_, other.migrationStep_);
+    }
+    Value & operator[](const Key & key)
+    {
+      auto result = insert(key, Value());
+      return (*(result.first)).second;
+    }
+    Value & at(const Key & key)
+    {
+      auto result = find(key);
+      if (result == end())
+      {
+        throw std::out_of_range("There are not value with specific key");
+      }
+      return (*result).second;
+    }
+    const Value & at(const Key & key) const
+    {
+      auto result = find(key);
+      if (result == cend())
+      {
+        throw std::out_of_range("There are not value with specific key");
+      }
+      return (*result).second;
+    }
+    bool empty() const noexcept
+    {
+      return (count_ == 0);
+    }
+    size_t bucketCount() const noexcept
+    {
+      return capacity_;
+    }
+    size_t size() const noexcept
+    {
+      return count_;
+    }
+    float loadFactor() const noexcept
+    {
+      return (capacity_ == 0) ? 0.0f : static_cast< float >(count_) / capacity_;
+    }
+    float maxLoadFactor() const noexcept
+    {
+      return maxLoadFactor_;
+    }
+    void maxLoadFactor(float factor)
+    {
+      if (!((factor > 0.0f) && (factor <= 1.0f)))
+      {
+        throw std::invalid_argument("Max load factor must be in (0, 1]");
+      }
+      maxLoadFactor_ = factor;
+      if (capacity_ == 0)
+      {
+        return;
+      }
+      growthLimit_ = limitFor(capacity_);
+      if (count_ + deleted_ > growthLimit_)
+      {
+        rehash(count_ + 1);
+      }
+    }
+    void reserve(size_t count)
+    {
+      if (count > growthLimit_)
+      {
+        rehash(count);
+      }
+    }
+    void clear() noexcept
+    {
+      releaseOld();
+      if (capacity_ == 0)
+      {
+        return;
+      }
+      destroySlots(controls_, slots_, capacity_);
+      std::memset(controls_, detail::controlEmpty, capacity_);
+      count_ = 0;
+      deleted_ = 0;
+    }
+    std::pair< flat_hash_table_iterator, bool > insert(const Key & key, const Value & value)
+    {
+      size_t hash = hashOf(key);
+      size_t index = probe(controls_, slots_, capacity_, key, hash);
+      if (index != capacity_)
+      {
+        return std::pair< flat_hash_table_iterator, bool >(makeIterator(index), false);
+      }
+      if (isMigrating())
+      {
+        index = probe(oldControls_, oldSlots_, oldCapacity_, key, hash);
+        if (index != oldCapacity_)
+        {
+          return std::pair< flat_hash_table_iterator, bool >(makeOldIterator(index), false);
+        }
+      }
+      if (count_ + deleted_ + 1 > growthLimit_)
+      {
+        rehash(count_ + 1);
+      }
+      if (isMigrating())
+      {
+        migrate(migrationStep_);
+      }
+      index = construct(hash, key, value);
+      ++count_;
+      return std::pair< flat_hash_table_iterator, bool >(makeIterator(index), true);
+    }
+    bool erase(const Key & key)
+    {
+      size_t hash = hashOf(key);
+      size_t index = probe(controls_, slots_, capacity_, key, hash);
+      if (index != capacity_)
+      {
+        eraseIndex(index);
+        return true;
+      }
+      if (isMigrating())
+      {
+        index = probe(oldControls_, oldSlots_, oldCapacity_, key, hash);
+        if (index != oldCapacity_)
+        {
+          eraseOldIndex(index);
+          return true;
+        }
+      }
+      return false;
+    }
+    flat_hash_table_iterator erase(flat_hash_table_iterator pos)
+    {
+      bool isOld = (pos.nextControl_ != nullptr);
+      size_t index = static_cast< size_t >(pos.control_ - (isOld ? oldControls_ : controls_));
+      ++pos;
+      if (isOld)
+      {
+        eraseOldIndex(index);
+      }
+      else
+      {
+        eraseIndex(index);
+      }
+      return pos;
+    }
+    flat_hash_table_iterator find(const Key & key)
+    {
+      size_t hash = hashOf(key);
+      size_t index = probe(controls_, slots_, capacity_, key, hash);
+      if ((index == capacity_) && isMigrating())
+      {
+        size_t oldIndex = probe(oldControls_, oldSlots_, oldCapacity_, key, hash);
+        if (oldIndex != oldCapacity_)
+        {
+          return makeOldIterator(oldIndex);
+        }
+      }
+      return makeIterator(index);
+    }
+    const_flat_hash_table_iterator find(const Key & key) const
+    {
+      size_t hash = hashOf(key);
+      size_t index = probe(controls_, slots_, capacity_, key, hash);
+      if ((index == capacity_) && isMigrating())
+      {
+        size_t oldIndex = probe(oldControls_, oldSlots_, oldCapacity_, key, hash);
+        if (oldIndex != oldCapacity_)
+        {
+          return makeOldIterator(oldIndex);
+        }
+      }
+      return makeIterator(index);
+    }
+    flat_hash_table_iterator begin()
+    {
+      flat_hash_table_iterator result = isMigrating() ? makeOldIterator(0) : makeIterator(0);
+      result.skipFree();
+      return result;
+    }
+    flat_hash_table_iterator end()
+    {
+      return makeIterator(capacity_);
+    }
+    const_flat_hash_table_iterator begin() const
+    {
+      return cbegin();
+    }
+    const_flat_hash_table_iterator end() const
+    {
+      return cend();
+    }
+    const_flat_hash_table_iterator cbegin() const
+    {
+      const_flat_hash_table_iterator result = isMigrating() ? makeOldIterator(0) : makeIterator(0);
+      result.skipFree();
+      return result;
+    }
+    const_flat_hash_table_iterator cend() const
+    {
+      return makeIterator(capacity_);
+    }
+    ~FlatHashTable()
+    {
+      releaseOld();
+      if (capacity_ != 0)
+      {
+        destroySlots(controls_, slots_, capacity_);
+        deallocate(controls_, slots_);
+      }
+    }
+  private:
+    size_t capacity_;
+    size_t count_;
+    size_t deleted_;
+    float maxLoadFactor_;
+    size_t growthLimit_;
+    control_t * controls_;
+    val_type_t * slots_;
+    size_t oldCapacity_;
+    control_t * oldControls_;
+    val_type_t * oldSlots_;
+    size_t migrated_;
+    size_t migrationStep_;
+    static control_t * emptyControls() noexcept
+    {
+      static control_t sentinel[1] = { detail::controlSentinel };
+      return sentinel;
+    }
+    static void allocate(size_t capacity, control_t *& controls, val_type_t *& slots)
+    {
+      controls = new control_t[capacity + 1];
+      std::memset(controls, detail::controlEmpty, capacity);
+      controls[capacity] = detail::controlSentinel;
+      try
+      {
+        slots = static_cast< val_type_t * >(::operator new(capacity * sizeof(val_type_t)));
+      }
+      catch (...)
+      {
+        delete[] controls;
+        throw;
+      }
+    }
+    static void deallocate(control_t * controls, val_type_t * slots) noexcept
+    {
+      delete[] controls;
+      ::operator delete(slots);
+    }
+    static void destroySlots(const control_t * controls, val_type_t * slots, size_t count) noexcept
+    {
+      for (size_t i = 0; i < count; ++i)
+      {
+        if (detail::isFull(controls[i]))
+        {
+          slots[i].~val_type_t();
+        }
+      }
+    }
+    static size_t hashOf(const Key & key)
+    {
+      return detail::mixHash(std::hash< Key >()(key));
+    }
+    static size_t probe(const control_t * controls, const val_type_t * slots, size_t capacity, const Key & key, size_t hash)
+    {
+      if (capacity == 0)
+      {
+        return capacity;
+      }
+      size_t mask = capacity - 1;
+      control_t fragment = detail::hashFragment(hash);
+      for (size_t index = detail::hashPosition(hash) & mask; controls[index] != detail::controlEmpty; index = (index + 1) & mask)
+      {
+        if ((controls[index] == fragment) && (slots[index].first == key))
+        {
+          return index;
+        }
+      }
+      return capacity;
+    }
+    size_t limitFor(size_t capacity) const noexcept
+    {
+      size_t limit = static_cast< size_t >(capacity * static_cast< double >(maxLoadFactor_));
+      return std::min(limit, capacity - 1);
+    }
+    bool isMigrating() const noexcept
+    {
+      return oldControls_ != nullptr;
+    }
+    flat_hash_table_iterator makeIterator(size_t index) const
+    {
+      return flat_hash_table_iterator(controls_ + index, slots_ + index);
+    }
+    flat_hash_table_iterator makeOldIterator(size_t index) const
+    {
+      return flat_hash_table_iterator(oldControls_ + index, oldSlots_ + index, controls_, slots_);
+    }
+    template< class... Args >
+    size_t construct(size_t hash, Args &&... args)
+    {
+      size_t mask = capacity_ - 1;
+      size_t index = detail::hashPosition(hash) & mask;
+      while (detail::isFull(controls_[index]))
+      {
+        index = (index + 1) & mask;
+      }
+      new (slots_ + index) val_type_t(std::forward< Args >(args)...);
+      if (controls_[index] == detail::controlDeleted)
+      {
+        --deleted_;
+      }
+      controls_[index] = detail::hashFragment(hash);
+      return index;
+    }
+    void eraseIndex(size_t index) noexcept
+    {
+      slots_[index].~val_type_t();
+      if (controls_[(index + 1) & (capacity_ - 1)] == detail::controlEmpty)
+      {
+        controls_[index] = detail::controlEmpty;
+      }
+      else
+      {
+        controls_[index] = detail::controlDeleted;
+        ++deleted_;
+      }
+      --count_;
+    }
+    void eraseOldIndex(size_t index) noexcept
+    {
+      oldSlots_[index].~val_type_t();
+      oldControls_[index] = detail::controlDeleted;
+      --count_;
+    }
+    void releaseOld() noexcept
+    {
+      if (isMigrating())
+      {
+        destroySlots(oldControls_, oldSlots_, oldCapacity_);
+        deallocate(oldControls_, oldSlots_);
+        oldCapacity_ = 0;
+        oldControls_ = nullptr;
+        oldSlots_ = nullptr;
+        migrated_ = 0;
+        migrationStep_ = 0;
+      }
+    }
+    void migrate(size_t steps)
+    {
+      size_t stop = std::min(migrated_ + steps, oldCapacity_);
+      for (; migrated_ < stop; ++migrated_)
+      {
+        if (detail::isFull(oldControls_[migrated_]))
+        {
+          construct(hashOf(oldSlots_[migrated_].first), std::move(oldSlots_[migrated_]));
+          oldSlots_[migrated_].~val_type_t();
+          oldControls_[migrated_] = detail::controlDeleted;
+        }
+      }
+      if (migrated_ == oldCapacity_)
+      {
+        releaseOld();
+      }
+    }
+    void rehash(size_t count)
+    {
+      if (isMigrating())
+      {
+        migrate(oldCapacity_);
+      }
+      size_t newCapacity = 8;
+      while (limitFor(newCapacity) < count)
+      {
+        newCapacity *= 2;
+      }
+      control_t * newControls = nullptr;
+      val_type_t * newSlots = nullptr;
+      allocate(newCapacity, newControls, newSlots);
+      if (count_ == 0)
+      {
+        if (capacity_ != 0)
+        {
+          deallocate(controls_, slots_);
+        }
+      }
+      else
+      {
+        oldCapacity_ = capacity_;
+        oldControls_ = controls_;
+        oldSlots_ = slots_;
+        migrated_ = 0;
+        migrationStep_ = 2 * oldCapacity_ / (limitFor(newCapacity) - count_) + 1;
+      }
+      capacity_ = newCapacity;
+      growthLimit_ = limitFor(newCapacity);
+      deleted_ = 0;
+      controls_ = newControls;
+      slots_ = newSlots;
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef FLAT_HASH_TABLE_CONTROL_HPP
+#define FLAT_HASH_TABLE_CONTROL_HPP
+
+#include <cstddef>
+
+namespace namestnikov
+{
+  namespace detail
+  {
+    using control_t = signed char;
+    constexpr control_t controlEmpty = -128;
+    constexpr control_t controlDeleted = -2;
+    constexpr control_t controlSentinel = -1;
+
+    inline bool isFull(control_t control)
+    {
+      return control >= 0;
+    }
+    inline size_t mixHash(size_t hash)
+    {
+      return hash * static_cast< size_t >(0x9E3779B97F4A7C15ull);
+    }
+    inline control_t hashFragment(size_t hash)
+    {
+      return static_cast< control_t >(hash & 0x7F);
+    }
+    inline size_t hashPosition(size_t hash)
+    {
+      return hash >> 7;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef FLAT_HASH_TABLE_ITERATORS_HPP
+#define FLAT_HASH_TABLE_ITERATORS_HPP
+
+#include <iterator>
+#include <utility>
+#include <flat_hash_table_control.hpp>
+
+namespace namestnikov
+{
+  template< class Key, class Value >
+  class FlatHashTable;
+
+  template< class Key, class Value >
+  class ConstFlatHashTableIterator;
+
+  template< class Key, class Value >
+  class FlatHashTableIterator: public std::iterator< std::forward_iterator_tag, std::pair< const Key, Value > >
+  {
+    friend class FlatHashTable< Key, Value >;
+    friend class ConstFlatHashTableIterator< Key, Value >;
+  public:
+    using val_type_t = std::pair< const Key, Value >;
+    using flat_hash_table_iterator = FlatHashTableIterator< Key, Value >;
+    FlatHashTableIterator(const flat_hash_table_iterator &) = default;
+    flat_hash_table_iterator & operator=(const flat_hash_table_iterator &) = default;
+    FlatHashTableIterator(flat_hash_table_iterator &&) = default;
+
+    bool operator==(const flat_hash_table_iterator & other) const
+    {
+      return control_ == other.control_;
+    }
+    bool operator!=(const flat_hash_table_iterator & other) const
+    {
+      return !(*this == other);
+    }
+    val_type_t & operator*() const
+    {
+      return *slot_;
+    }
+    val_type_t * operator->() const
+    {
+      return slot_;
+    }
+    flat_hash_table_iterator & operator++()
+    {
+      ++control_;
+      ++slot_;
+      skipFree();
+      return *this;
+    }
+    flat_hash_table_iterator operator++(int)
+    {
+      flat_hash_table_iterator temp(*this);
+      ++(*this);
+      return temp;
+    }
+    ~FlatHashTableIterator() = default;
+  private:
+    const detail::control_t * control_;
+    val_type_t * slot_;
+    const detail::control_t * nextControl_;
+    val_type_t * nextSlot_;
+    FlatHashTableIterator(const detail::control_t * control, val_type_t * slot):
+      FlatHashTableIterator(control, slot, nullptr, nullptr)
+    {}
+    FlatHashTableIterator(const detail::control_t * control, val_type_t * slot,
+      const detail::control_t * nextControl, val_type_t * nextSlot):
+      control_(control),
+      slot_(slot),
+      nextControl_(nextControl),
+      nextSlot_(nextSlot)
+    {}
+    void skipFree()
+    {
+      while (*control_ < detail::controlSentinel)
+      {
+        ++control_;
+        ++slot_;
+      }
+      if ((*control_ == detail::controlSentinel) && (nextControl_ != nullptr))
+      {
+        control_ = nextControl_;
+        slot_ = nextSlot_;
+        nextControl_ = nullptr;
+        nextSlot_ = nullptr;
+        skipFree();
+      }
+    }
+  };
+}
+
+#endif
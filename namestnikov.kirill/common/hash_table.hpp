@@ -1,11 +1,13 @@
 #ifndef HASH_TABLE_HPP
 #define HASH_TABLE_HPP
 
+#include <algorithm>
 #include <initializer_list>
 #include <stdexcept>
 #include <cmath>
 #include <cstddef>
 #include <utility>
+#include <hash_table_growth.hpp>
 #include <hash_table_node.hpp>
 #include <bidirectional_list.hpp>
 #include <hash_table_iterators.hpp>
@@ -24,12 +26,16 @@ namespace namestnikov
     using const_hash_table_iterator = ConstHashTableIterator< Key, Value >;
 
     HashTable():
-      capacity_(5),
+      HashTable(5)
+    {}
+    explicit HashTable(size_t bucketCount):
+      capacity_(detail::nextBucketCount(bucketCount)),
       count_(0),
-      buckets_(new list_iterator[5]),
+      maxLoadFactor_(0.75f),
+      buckets_(new list_iterator[capacity_]),
       elements_()
     {
-      for (size_t i = 0; i < 5; ++i)
+      for (size_t i = 0; i < capacity_; ++i)
       {
         buckets_[i] = elements_.end();
       }
@@ -37,6 +43,7 @@ namespace namestnikov
     HashTable(const HashTable< Key, Value > & other):
       capacity_(other.capacity_),
       count_(0),
+      maxLoadFactor_(other.maxLoadFactor_),
       buckets_(new list_iterator[other.capacity_]),
       elements_()
     {
@@ -75,6 +82,7 @@ namespace namestnikov
     HashTable(HashTable< Key, Value > && other) noexcept:
       capacity_(other.capacity_),
       count_(other.count_),
+      maxLoadFactor_(other.maxLoadFactor_),
       buckets_(other.buckets_),
       elements_(std::move(other.elements_))
     {
@@ -95,6 +103,7 @@ namespace namestnikov
     {
       std::swap(capacity_, other.capacity_);
       std::swap(count_, other.count_);
+      std::swap(maxLoadFactor_, other.maxLoadFactor_);
       std::swap(elements_, other.elements_);
       std::swap(buckets_, other.buckets_);
     }
@@ -133,6 +142,33 @@ namespace namestnikov
     {
       return count_;
     }
+    float loadFactor() const noexcept
+    {
+      return static_cast< float >(count_) / capacity_;
+    }
+    float maxLoadFactor() const noexcept
+    {
+      return maxLoadFactor_;
+    }
+    void maxLoadFactor(float factor)
+    {
+      if (!(factor > 0.0f))
+      {
+        throw std::invalid_argument("Max load factor must be positive");
+      }
+      maxLoadFactor_ = factor;
+      if (count_ > capacity_ * maxLoadFactor_)
+      {
+        rehash(0);
+      }
+    }
+    void reserve(size_t count)
+    {
+      if (minBucketCount(count) > capacity_)
+      {
+        rehash(minBucketCount(count));
+      }
+    }
     void clear()
     {
       auto it = elements_.begin();
@@ -221,15 +257,12 @@ namespace namestnikov
   private:
     size_t capacity_;
     size_t count_;
+    float maxLoadFactor_;
     list_iterator * buckets_;
     List< node_t * > elements_;
     void rehash(size_t count)
     {
-      size_t newCapacity = 5;
-      while ((newCapacity < count) || (newCapacity < (count_ / 0.75)))
-      {
-        newCapacity = calculateNextCapacity(newCapacity);
-      }
+      size_t newCapacity = detail::nextBucketCount(std::max(count, minBucketCount(count_)));
       if (newCapacity == capacity_)
       {
         return;
@@ -273,12 +306,9 @@ namespace namestnikov
         throw;
       }
     }
-    size_t calculateNextCapacity(size_t current) const
+    size_t minBucketCount(size_t count) const
     {
-      size_t powDegree = 0;
-      for (; current > std::pow(2, powDegree); ++powDegree) {};
-      ++powDegree;
-      return std::pow(2, powDegree) - (std::pow(2, powDegree) - std::pow(2, powDegree - 1)) / 2 - 1;
+      return static_cast< size_t >(std::ceil(count / maxLoadFactor_));
     }
     hash_table_iterator find(const Key & key, size_t hash)
     {
@@ -332,9 +362,9 @@ namespace namestnikov
           return std::pair< hash_table_iterator, bool >(desired, false);
         }
         size_t index = hash % capacity_;
-        if (capacity_ < ((count_ + 1) / 0.75))
+        if ((count_ + 1) > capacity_ * maxLoadFactor_)
         {
-          rehash(calculateNextCapacity(capacity_));
+          rehash(detail::nextBucketCount(capacity_ + 1));
           index = hash % capacity_;
         }
 
@@ -0,0 +1,32 @@
+#ifndef HASH_TABLE_GROWTH_HPP
+#define HASH_TABLE_GROWTH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+
+namespace namestnikov
+{
+  namespace detail
+  {
+    constexpr size_t bucketCounts[] = {
+      5, 11, 23, 47, 97, 197, 397, 797, 1597, 3203, 6421, 12853, 25717, 51437, 102877, 205759,
+      411527, 823117, 1646237, 3292489, 6584983, 13169977, 26339969, 52679969, 105359939,
+      210719881, 421439783, 842879579, 1685759167, 3371518343u, 4294967291u
+    };
+
+    inline size_t nextBucketCount(size_t count)
+    {
+      const size_t * last = std::end(bucketCounts);
+      const size_t * result = std::lower_bound(std::begin(bucketCounts), last, count);
+      if (result == last)
+      {
+        throw std::length_error("Too many buckets requested");
+      }
+      return *result;
+    }
+  }
+}
+
+#endif
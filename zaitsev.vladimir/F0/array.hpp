@@ -0,0 +1,133 @@
+#ifndef ARRAY_HPP
+#define ARRAY_HPP
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace zaitsev
+{
+  template< typename T >
+  struct Array
+  {
+    Array() = delete;
+    Array(size_t size):
+      size_(size),
+      vals_(reinterpret_cast<T*>(new char[sizeof(T) * size]))
+    {}
+    Array(size_t size, const T& val):
+      size_(size),
+      vals_(reinterpret_cast< T* >(new char[sizeof(T) * size]))
+    {
+      size_t i = 0;
+      try
+      {
+        for (; i < size_; ++i)
+        {
+          new (vals_ + i) T(val);
+        }
+      }
+      catch (...)
+      {
+        for (size_t j = 0; j < i; ++j)
+        {
+          vals_[j].~T();
+        }
+        delete[] reinterpret_cast< char* >(vals_);
+        throw;
+      }
+    }
+    Array(const Array& other):
+      size_(other.size_),
+      vals_(reinterpret_cast< T* >(new char[sizeof(T) * other.size_]))
+    {
+      size_t i = 0;
+      try
+      {
+        for (; i < size_; ++i)
+        {
+          new (vals_ + i) T(other[i]);
+        }
+      }
+      catch (...)
+      {
+        for (size_t j = 0; j < i; ++j)
+        {
+          vals_[j].~T();
+        }
+        delete[] reinterpret_cast< char* >(vals_);
+        throw;
+      }
+    }
+    Array(Array&& other) noexcept:
+      size_(other.size_),
+      vals_(other.vals_)
+    {
+      other.size_ = 0;
+      other.vals_ = 0;
+    }
+    Array& operator=(const Array& other)
+    {
+      if (this != std::addressof(other))
+      {
+        Array temp(other);
+        swap(temp);
+      }
+      return *this;
+    }
+    Array& operator=(Array&& other) noexcept
+    {
+      if (this != std::addressof(other))
+      {
+        Array temp(std::move(other));
+        swap(temp);
+      }
+      return *this;
+    }
+    ~Array()
+    {
+      for (size_t i = 0; i < size_; ++i)
+      {
+        vals_[i].~T();
+      }
+      delete[] reinterpret_cast<char*>(vals_);
+    }
+    void swap(Array& other) noexcept
+    {
+      std::swap(size_, other.size_);
+      std::swap(vals_, other.vals_);
+    }
+    size_t size() const
+    {
+      return size_;
+    }
+    T* begin()
+    {
+      return vals_;
+    }
+    const T* begin() const
+    {
+      return vals_;
+    }
+    T* end()
+    {
+      return vals_ + size_;
+    }
+    const T* end() const
+    {
+      return vals_ + size_;
+    }
+    T& operator[](size_t index)
+    {
+      return vals_[index];
+    }
+    const T& operator[](size_t index) const
+    {
+      return vals_[index];
+    }
+  private:
+    size_t size_;
+    T* vals_;
+  };
+}
+#endif
@@ -0,0 +1,209 @@
+#include "graph.hpp"
+#include <algorithm>
+#include <utility>
+
+zaitsev::CompiledGraph::CompiledGraph():
+  names_(0),
+  offsets_(1, 0),
+  targets_(0),
+  weights_(0),
+  has_negative_weights_(false)
+{}
+
+zaitsev::CompiledGraph::CompiledGraph(const graph_t& graph):
+  names_(graph.size(), std::string()),
+  offsets_(graph.size() + 1, 0),
+  targets_(0),
+  weights_(0),
+  has_negative_weights_(false)
+{
+  size_t i = 0;
+  size_t edges_nmb = 0;
+  for (auto& vert : graph)
+  {
+    names_[i] = vert.first;
+    edges_nmb += vert.second.size();
+    ++i;
+  }
+  Array< size_t > targets(edges_nmb);
+  Array< int > weights(edges_nmb);
+  size_t k = 0;
+  i = 0;
+  for (auto& vert : graph)
+  {
+    for (auto& edge : vert.second)
+    {
+      size_t end = findIndex(edge.first);
+      if (end != size())
+      {
+        targets[k] = end;
+        weights[k] = edge.second;
+        has_negative_weights_ = has_negative_weights_ || edge.second < 0;
+        ++k;
+      }
+    }
+    offsets_[++i] = k;
+  }
+  targets_.swap(targets);
+  weights_.swap(weights);
+}
+
+zaitsev::CompiledGraph::CompiledGraph(Array< std::string >&& names, Array< size_t >&& offsets, Array< size_t >&& targets,
+  Array< int >&& weights):
+  names_(std::move(names)),
+  offsets_(std::move(offsets)),
+  targets_(std::move(targets)),
+  weights_(std::move(weights)),
+  has_negative_weights_(false)
+{
+  for (size_t i = 0; i < edgesNumber(); ++i)
+  {
+    has_negative_weights_ = has_negative_weights_ || weights_[i] < 0;
+  }
+}
+
+size_t zaitsev::CompiledGraph::size() const
+{
+  return names_.size();
+}
+
+size_t zaitsev::CompiledGraph::edgesNumber() const
+{
+  return offsets_[size()];
+}
+
+size_t zaitsev::CompiledGraph::findIndex(const std::string& name) const
+{
+  const std::string* pos = std::lower_bound(names_.begin(), names_.end(), name);
+  return (pos != names_.end() && *pos == name) ? pos - names_.begin() : size();
+}
+
+const std::string& zaitsev::CompiledGraph::name(size_t index) const
+{
+  return names_[index];
+}
+
+size_t zaitsev::CompiledGraph::edgesBegin(size_t index) const
+{
+  return offsets_[index];
+}
+
+size_t zaitsev::CompiledGraph::edgesEnd(size_t index) const
+{
+  return offsets_[index + 1];
+}
+
+size_t zaitsev::CompiledGraph::target(size_t edge) const
+{
+  return targets_[edge];
+}
+
+int zaitsev::CompiledGraph::weight(size_t edge) const
+{
+  return weights_[edge];
+}
+
+bool zaitsev::CompiledGraph::hasNegativeWeights() const
+{
+  return has_negative_weights_;
+}
+
+zaitsev::graph_t zaitsev::CompiledGraph::expand() const
+{
+  graph_t graph;
+  for (size_t i = 0; i < size(); ++i)
+  {
+    unit_t& unit = graph[names_[i]];
+    for (size_t k = edgesBegin(i); k < edgesEnd(i); ++k)
+    {
+      unit[names_[targets_[k]]] = weights_[k];
+    }
+  }
+  return graph;
+}
+
+void zaitsev::CompiledGraph::swap(CompiledGraph& other) noexcept
+{
+  names_.swap(other.names_);
+  offsets_.swap(other.offsets_);
+  targets_.swap(other.targets_);
+  weights_.swap(other.weights_);
+  std::swap(has_negative_weights_, other.has_negative_weights_);
+}
+
+zaitsev::Graph::Graph():
+  vertices_(),
+  has_vertices_(true),
+  version_(0),
+  compiled_(),
+  compiled_version_(0),
+  cache_()
+{}
+
+zaitsev::Graph::Graph(graph_t&& vertices):
+  vertices_(std::move(vertices)),
+  has_vertices_(true),
+  version_(1),
+  compiled_(),
+  compiled_version_(0),
+  cache_()
+{}
+
+zaitsev::Graph::Graph(CompiledGraph&& compiled):
+  vertices_(),
+  has_vertices_(false),
+  version_(1),
+  compiled_(std::move(compiled)),
+  compiled_version_(1),
+  cache_()
+{}
+
+const zaitsev::graph_t& zaitsev::Graph::vertices() const
+{
+  if (!has_vertices_)
+  {
+    vertices_ = compiled_.expand();
+    has_vertices_ = true;
+  }
+  return vertices_;
+}
+
+void zaitsev::Graph::addVertex(const std::string& name)
+{
+  const Graph& self = *this;
+  self.vertices();
+  vertices_.insert({ name, unit_t{} });
+  ++version_;
+}
+
+void zaitsev::Graph::addEdge(const std::string& begin, const std::string& end, int weight)
+{
+  const Graph& self = *this;
+  self.vertices();
+  vertices_[begin][end] = weight;
+  if (vertices_.find(end) == vertices_.end())
+  {
+    vertices_.insert({ end, unit_t{} });
+  }
+  ++version_;
+}
+
+const zaitsev::CompiledGraph& zaitsev::Graph::compiled() const
+{
+  if (compiled_version_ != version_)
+  {
+    CompiledGraph compiled(vertices_);
+    compiled_.swap(compiled);
+    compiled_version_ = version_;
+  }
+  return compiled_;
+}
+
+zaitsev::PathCache& zaitsev::Graph::cache() const
+{
+  if (cache_.version() != version_)
+  {
+    cache_.reset(version_);
+  }
+  return cache_;
+}
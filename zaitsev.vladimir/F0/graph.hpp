@@ -0,0 +1,59 @@
+#ifndef GRAPH_HPP
+#define GRAPH_HPP
+#include <cstddef>
+#include <string>
+#include <map.hpp>
+#include "array.hpp"
+#include "path_cache.hpp"
+
+namespace zaitsev
+{
+  using unit_t = Map< std::string, int >;
+  using graph_t = Map< std::string, unit_t >;
+
+  class CompiledGraph
+  {
+  public:
+    CompiledGraph();
+    explicit CompiledGraph(const graph_t& graph);
+    CompiledGraph(Array< std::string >&& names, Array< size_t >&& offsets, Array< size_t >&& targets, Array< int >&& weights);
+    size_t size() const;
+    size_t edgesNumber() const;
+    size_t findIndex(const std::string& name) const;
+    const std::string& name(size_t index) const;
+    size_t edgesBegin(size_t index) const;
+    size_t edgesEnd(size_t index) const;
+    size_t target(size_t edge) const;
+    int weight(size_t edge) const;
+    bool hasNegativeWeights() const;
+    graph_t expand() const;
+    void swap(CompiledGraph& other) noexcept;
+  private:
+    Array< std::string > names_;
+    Array< size_t > offsets_;
+    Array< size_t > targets_;
+    Array< int > weights_;
+    bool has_negative_weights_;
+  };
+
+  class Graph
+  {
+  public:
+    Graph();
+    explicit Graph(graph_t&& vertices);
+    explicit Graph(CompiledGraph&& compiled);
+    const graph_t& vertices() const;
+    void addVertex(const std::string& name);
+    void addEdge(const std::string& begin, const std::string& end, int weight);
+    const CompiledGraph& compiled() const;
+    PathCache& cache() const;
+  private:
+    mutable graph_t vertices_;
+    mutable bool has_vertices_;
+    size_t version_;
+    mutable CompiledGraph compiled_;
+    mutable size_t compiled_version_;
+    mutable PathCache cache_;
+  };
+}
+#endif
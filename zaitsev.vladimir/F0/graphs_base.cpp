@@ -49,11 +49,12 @@ void zaitsev::addVertex(base_t& graphs, const args_flist& args, std::ostream&)
   {
     throw std::invalid_argument("No graph \"" + graph_name + "\" in the base");
   }
-  if (it->second.find(vertex_name) != it->second.end())
+  const Graph& graph = it->second;
+  if (graph.vertices().find(vertex_name) != graph.vertices().end())
   {
     throw std::invalid_argument("Vertex \"" + vertex_name + "\" already exists");
   }
-  it->second.insert({ vertex_name, unit_t{} });
+  it->second.addVertex(vertex_name);
 }
 
 void zaitsev::addEdge(base_t& graphs, const args_flist& args, std::ostream&)
@@ -83,28 +84,13 @@ void zaitsev::addEdge(base_t& graphs, const args_flist& args, std::ostream&)
   {
     throw std::invalid_argument("Such graph doesn't found");
   }
-  auto it_beg = it_graph->second.find(begin);
-  if (it_beg != it_graph->second.end())
+  const graph_t& vertices = it_graph->second.vertices();
+  auto it_beg = vertices.find(begin);
+  if (check && it_beg != vertices.end() && it_beg->second.find(end) != it_beg->second.end())
   {
-    if (!check || (check && it_beg->second.find(end) == it_beg->second.end()))
-    {
-      it_beg->second[end] = value;
-    }
-    else
-    {
-      throw std::invalid_argument("Edge already exists");
-    }
-  }
-  else
-  {
-    std::pair< std::string, unit_t > to_add = { begin, unit_t{} };
-    to_add.second.insert({ end, value });
-    it_graph->second.insert(std::move(to_add));
-  }
-  if (it_graph->second.find(end) == it_graph->second.end())
-  {
-    it_graph->second.insert({ end, unit_t{} });
+    throw std::invalid_argument("Edge already exists");
   }
+  it_graph->second.addEdge(begin, end, value);
 }
 
 void zaitsev::mergeGraphs(base_t& graphs, const args_flist& args, std::ostream&)
@@ -132,8 +118,9 @@ void zaitsev::mergeGraphs(base_t& graphs, const args_flist& args, std::ostream&)
   {
     throw std::invalid_argument("Invalid arguments");
   }
-  graph_t new_graph = graphs.find(nm_2)->second;
-  const graph_t& graph_1_inst = graphs.find(nm_1)->second;
+  const base_t& base = graphs;
+  graph_t new_graph = base.find(nm_2)->second.vertices();
+  const graph_t& graph_1_inst = base.find(nm_1)->second.vertices();
 
   for (auto& i : graph_1_inst)
   {
@@ -163,6 +150,6 @@ void zaitsev::mergeGraphs(base_t& graphs, const args_flist& args, std::ostream&)
       }
     }
   }
-  graphs[new_nm] = std::move(new_graph);
+  graphs[new_nm] = Graph(std::move(new_graph));
   return;
 }
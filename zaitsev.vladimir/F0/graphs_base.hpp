@@ -3,13 +3,12 @@
 #include <ostream>
 #include <string>
 #include <map.hpp>
+#include "graph.hpp"
 
 namespace zaitsev
 {
   using args_flist = ForwardList< std::string >;
-  using unit_t = Map< std::string, int >;
-  using graph_t = Map< std::string, unit_t >;
-  using base_t = Map < std::string, graph_t >;
+  using base_t = Map < std::string, Graph >;
 
   void createGraph(base_t& graphs, const args_flist& args, std::ostream&);
   void deleteGraph(base_t& graphs, const args_flist& args, std::ostream&);
@@ -3,6 +3,7 @@
 #include <string>
 #include <iomanip>
 #include "delimiter.hpp"
+#include "snapshot.hpp"
 
 zaitsev::graph_t basicGraphRead(std::istream& in);
 void basicGraphPrint(std::ostream& out, const zaitsev::graph_t& graph, size_t indnent_sz = 2);
@@ -60,7 +61,7 @@ void zaitsev::printHelp()
   cout << "Help:\n";
   cout << "1. read <file> <graph>\n" << indent;
   cout << "Read the graph from the file <file>, and assign it the name <graph>.\n\n";
-  cout << "2. write <graph> <file>\n" << indent;
+  cout << "2. write [-binary] <graph> <file>\n" << indent;
   cout << "Write a graph <graph> to a file <file>.\n\n";
   cout << "3. listgraphs\n" << indent;
   cout << "Output a lexicographically ordered list of available graphs.\n\n";
@@ -77,15 +78,17 @@ void zaitsev::printHelp()
   cout << "9. merge [-check] <new-graph> <graph-1> <graph-2> \n" << indent;
   cout << "A new graph <new-graph> is created, which is a union of graphs <graph-1> and <graph-2>.\n\n";
   cout << "10. negativeweightcycles <graph>\n" << indent;
-  cout << "Display a message about the presence/absence of a negative weight cycle in graph.\n\n";
+  cout << "Display a message about the presence/absence of a negative weight cycle in graph and print the cycle found.\n\n";
   cout << "11. shortestdistance <graph> <begin> <end>\n" << indent;
   cout << "Calculate the length of the shortest path from <begin> to <end> in the graph <graph>.\n\n";
   cout << "12. shortesttrace <graph> <begin> <end>\n" << indent;
   cout << "Print the shortest path from <begin> to <end> in the graph <graph>.\n\n";
-  cout << "13. shortestpathmatrix <graph>\n" << indent;
+  cout << "13. shortestpathmatrix [-parallel] <graph>\n" << indent;
   cout << "Output the matrix of shortest paths between all vertices.\n\n";
-  cout << "14. dump <file>\n" << indent;
+  cout << "14. dump [-binary] <file>\n" << indent;
   cout << "Create a file <file> in which all graphs saved in the program are written.\n\n";
+  cout << "15. cachestats\n" << indent;
+  cout << "Output the hit rates of cached shortest path queries for every graph.\n\n";
   return;
 }
 
@@ -103,29 +106,46 @@ std::ostream& zaitsev::printGraph(const base_t& graphs, const args_flist& args,
     throw std::invalid_argument("Graph with name \"" + arg + "\" doesn't exists.");
   }
   out << "Graph name: " << graph->first << '\n';
-  basicGraphPrint(out, graph->second);
+  basicGraphPrint(out, graph->second.vertices());
   return out;
 }
 
 void zaitsev::dump(const base_t& graphs, const args_flist& args, std::ostream&)
 {
   size_t args_nmb = std::distance(args.cbegin(), args.cend());
-  if (args_nmb != 2)
+  args_flist::const_iterator arg_it = args.cbegin();
+  if (args_nmb > 3 || args_nmb < 2 || (args_nmb == 2 && (*std::next(arg_it))[0] == '-'))
   {
     throw std::invalid_argument("Invalid number of arguments");
   }
-  const std::string& arg = *(++args.cbegin());
+  bool binary = false;
+  if (args_nmb == 3)
+  {
+    ++arg_it;
+    if (*arg_it != "-binary")
+    {
+      throw std::invalid_argument("Invalid option");
+    }
+    binary = true;
+  }
+  const std::string& arg = *(++arg_it);
   if (std::ifstream(arg).good())
   {
     throw std::invalid_argument("File already exists");
   }
 
+  if (binary)
+  {
+    std::ofstream out(arg, std::ios::binary);
+    writeSnapshot(out, graphs.cbegin(), graphs.cend());
+    return;
+  }
   std::ofstream out(arg);
   out << "Graphs number: " << graphs.size() << '\n';
   for (auto& i : graphs)
   {
     out << "Graph name: " << i.first << '\n';
-    basicGraphPrint(out, i.second);
+    basicGraphPrint(out, i.second.vertices());
     out << '\n';
   }
   return;
@@ -137,7 +157,16 @@ void zaitsev::initBase(const char* file, base_t& base)
   {
     throw std::invalid_argument("Initial file does't found");
   }
-  std::ifstream in(file);
+  std::ifstream in(file, std::ios::binary);
+  if (isSnapshot(in))
+  {
+    base_t snapshot = readSnapshot(in);
+    for (auto& i : snapshot)
+    {
+      base[i.first] = std::move(i.second);
+    }
+    return;
+  }
   using del = zaitsev::Delimiter;
   size_t graphs_nmb = 0;
   in >> Delimiter{ "Graphs" } >> del{"number:" } >> graphs_nmb;
@@ -149,7 +178,7 @@ void zaitsev::initBase(const char* file, base_t& base)
   {
     std::string graph_name;
     in >> del{ "Graph" } >> del{ "name:" } >> graph_name;
-    base[graph_name] = basicGraphRead(in);
+    base[graph_name] = Graph(basicGraphRead(in));
   }
   return;
 }
@@ -168,12 +197,22 @@ void zaitsev::readGraph(base_t& graphs, const args_flist& args, std::ostream&)
   {
     throw std::invalid_argument("Graph with name \"" + graph_name + "\" already exists.");
   }
-  std::ifstream input_file(file);
+  std::ifstream input_file(file, std::ios::binary);
   if (!input_file.good())
   {
     throw std::invalid_argument("File \"" + file + "\" does't found");
   }
-  graphs[graph_name] = basicGraphRead(input_file);
+  if (isSnapshot(input_file))
+  {
+    base_t snapshot = readSnapshot(input_file);
+    if (snapshot.size() != 1)
+    {
+      throw std::invalid_argument("Snapshot must contain exactly one graph");
+    }
+    graphs[graph_name] = std::move(snapshot.begin()->second);
+    return;
+  }
+  graphs[graph_name] = Graph(basicGraphRead(input_file));
   return;
 }
 
@@ -181,23 +220,39 @@ void zaitsev::writeGraph(const base_t& graphs, const args_flist& args, std::ostr
 {
   size_t args_nmb = std::distance(args.cbegin(), args.cend());
   args_flist::const_iterator arg = args.cbegin();
-  if (args_nmb != 3)
+  if (args_nmb > 4 || args_nmb < 3 || (args_nmb == 3 && (*std::next(arg))[0] == '-'))
   {
     throw std::invalid_argument("Invalid number of arguments");
   }
+  bool binary = false;
+  if (args_nmb == 4)
+  {
+    ++arg;
+    if (*arg != "-binary")
+    {
+      throw std::invalid_argument("Invalid option");
+    }
+    binary = true;
+  }
   const std::string& graph_name = *(++arg);
   const std::string& file = *(++arg);
   if (std::ifstream(file).good())
   {
     throw std::invalid_argument("File \"" + file + "\" already exists");
   }
-  std::ofstream out(file);
   base_t::const_iterator graph = graphs.find(graph_name);
   if (graph == graphs.end())
   {
     throw std::invalid_argument("Graph with name \"" + graph_name + "\" doesn't exist.");
   }
-  basicGraphPrint(out, graph->second);
+  if (binary)
+  {
+    std::ofstream out(file, std::ios::binary);
+    writeSnapshot(out, graph, std::next(graph));
+    return;
+  }
+  std::ofstream out(file);
+  basicGraphPrint(out, graph->second.vertices());
   return;
 }
 
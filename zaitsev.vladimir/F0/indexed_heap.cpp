@@ -0,0 +1,69 @@
+#include "indexed_heap.hpp"
+#include <utility>
+
+zaitsev::IndexedHeap::IndexedHeap(size_t capacity):
+  heap_(capacity),
+  positions_(capacity, capacity),
+  keys_(capacity),
+  size_(0)
+{}
+
+bool zaitsev::IndexedHeap::empty() const
+{
+  return size_ == 0;
+}
+
+void zaitsev::IndexedHeap::push(size_t id, long long key)
+{
+  if (positions_[id] == positions_.size())
+  {
+    heap_[size_] = id;
+    positions_[id] = size_;
+    ++size_;
+  }
+  keys_[id] = key;
+  siftUp(positions_[id]);
+}
+
+size_t zaitsev::IndexedHeap::pop()
+{
+  size_t top = heap_[0];
+  swapNodes(0, --size_);
+  positions_[top] = positions_.size();
+  siftDown(0);
+  return top;
+}
+
+void zaitsev::IndexedHeap::swapNodes(size_t i, size_t j)
+{
+  std::swap(heap_[i], heap_[j]);
+  positions_[heap_[i]] = i;
+  positions_[heap_[j]] = j;
+}
+
+void zaitsev::IndexedHeap::siftUp(size_t i)
+{
+  while (i > 0 && keys_[heap_[i]] < keys_[heap_[(i - 1) / 2]])
+  {
+    swapNodes(i, (i - 1) / 2);
+    i = (i - 1) / 2;
+  }
+}
+
+void zaitsev::IndexedHeap::siftDown(size_t i)
+{
+  while (2 * i + 1 < size_)
+  {
+    size_t child = 2 * i + 1;
+    if (child + 1 < size_ && keys_[heap_[child + 1]] < keys_[heap_[child]])
+    {
+      ++child;
+    }
+    if (!(keys_[heap_[child]] < keys_[heap_[i]]))
+    {
+      break;
+    }
+    swapNodes(i, child);
+    i = child;
+  }
+}
@@ -0,0 +1,25 @@
+#ifndef INDEXED_HEAP_HPP
+#define INDEXED_HEAP_HPP
+#include <cstddef>
+#include "array.hpp"
+
+namespace zaitsev
+{
+  class IndexedHeap
+  {
+  public:
+    explicit IndexedHeap(size_t capacity);
+    bool empty() const;
+    void push(size_t id, long long key);
+    size_t pop();
+  private:
+    Array< size_t > heap_;
+    Array< size_t > positions_;
+    Array< long long > keys_;
+    size_t size_;
+    void swapNodes(size_t i, size_t j);
+    void siftUp(size_t i);
+    void siftDown(size_t i);
+  };
+}
+#endif
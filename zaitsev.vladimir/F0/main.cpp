@@ -72,6 +72,7 @@ int main(int argc, char** argv)
     commands["shortesttrace"] = std::bind(findShortestPathTtrace, std::cref(graphs), _1, _2);
     commands["shortestpathmatrix"] = std::bind(printShortestPathsMatrix, std::cref(graphs), _1, _2);
     commands["dump"] = std::bind(dump, std::ref(graphs), _1, _2);
+    commands["cachestats"] = std::bind(printCacheStats, std::cref(graphs), _1, _2);
   }
   args_flist args;
   while (!std::cin.eof())
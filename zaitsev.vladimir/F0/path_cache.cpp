@@ -0,0 +1,98 @@
+#include "path_cache.hpp"
+#include <utility>
+
+namespace
+{
+  constexpr size_t paths_cache_capacity = 32;
+  constexpr size_t no_source = static_cast< size_t >(-1);
+}
+
+zaitsev::ShortestPaths::ShortestPaths():
+  distances(0),
+  previous(0)
+{}
+
+zaitsev::ShortestPaths::ShortestPaths(Array< int >&& dist, Array< size_t >&& prev):
+  distances(std::move(dist)),
+  previous(std::move(prev))
+{}
+
+zaitsev::PathCache::PathCache():
+  version_(0),
+  sources_(paths_cache_capacity, no_source),
+  paths_(paths_cache_capacity, ShortestPaths()),
+  next_slot_(0),
+  matrix_(0),
+  has_matrix_(false),
+  paths_stats_{ 0, 0 },
+  matrix_stats_{ 0, 0 }
+{}
+
+size_t zaitsev::PathCache::version() const
+{
+  return version_;
+}
+
+void zaitsev::PathCache::reset(size_t version)
+{
+  version_ = version;
+  for (size_t i = 0; i < sources_.size(); ++i)
+  {
+    sources_[i] = no_source;
+    paths_[i] = ShortestPaths();
+  }
+  next_slot_ = 0;
+  matrix_ = Array< int >(0);
+  has_matrix_ = false;
+}
+
+const zaitsev::ShortestPaths* zaitsev::PathCache::findPaths(size_t source)
+{
+  for (size_t i = 0; i < sources_.size(); ++i)
+  {
+    if (sources_[i] == source)
+    {
+      ++paths_stats_.hits;
+      return &paths_[i];
+    }
+  }
+  ++paths_stats_.misses;
+  return nullptr;
+}
+
+const zaitsev::ShortestPaths& zaitsev::PathCache::addPaths(size_t source, ShortestPaths&& paths)
+{
+  size_t slot = next_slot_;
+  next_slot_ = (next_slot_ + 1) % sources_.size();
+  sources_[slot] = source;
+  paths_[slot] = std::move(paths);
+  return paths_[slot];
+}
+
+const zaitsev::Array< int >* zaitsev::PathCache::findMatrix()
+{
+  if (has_matrix_)
+  {
+    ++matrix_stats_.hits;
+    return &matrix_;
+  }
+  ++matrix_stats_.misses;
+  return nullptr;
+}
+
+const zaitsev::Array< int >& zaitsev::PathCache::addMatrix(Array< int >&& matrix)
+{
+  matrix_ = std::move(matrix);
+  has_matrix_ = true;
+  return matrix_;
+}
+
+const zaitsev::CacheStats& zaitsev::PathCache::pathsStats() const
+{
+  return paths_stats_;
+}
+
+const zaitsev::CacheStats& zaitsev::PathCache::matrixStats() const
+{
+  return matrix_stats_;
+}
@@ -0,0 +1,45 @@
+#ifndef PATH_CACHE_HPP
+#define PATH_CACHE_HPP
+#include <cstddef>
+#include "array.hpp"
+
+namespace zaitsev
+{
+  struct ShortestPaths
+  {
+    ShortestPaths();
+    ShortestPaths(Array< int >&& dist, Array< size_t >&& prev);
+    Array< int > distances;
+    Array< size_t > previous;
+  };
+
+  struct CacheStats
+  {
+    size_t hits;
+    size_t misses;
+  };
+
+  class PathCache
+  {
+  public:
+    PathCache();
+    size_t version() const;
+    void reset(size_t version);
+    const ShortestPaths* findPaths(size_t source);
+    const ShortestPaths& addPaths(size_t source, ShortestPaths&& paths);
+    const Array< int >* findMatrix();
+    const Array< int >& addMatrix(Array< int >&& matrix);
+    const CacheStats& pathsStats() const;
+    const CacheStats& matrixStats() const;
+  private:
+    size_t version_;
+    Array< size_t > sources_;
+    Array< ShortestPaths > paths_;
+    size_t next_slot_;
+    Array< int > matrix_;
+    bool has_matrix_;
+    CacheStats paths_stats_;
+    CacheStats matrix_stats_;
+  };
+}
+#endif
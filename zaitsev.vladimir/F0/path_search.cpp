@@ -1,127 +1,40 @@
 #include "path_search.hpp"
 #include <string>
 #include <algorithm>
+#include <functional>
 #include <iomanip>
 #include <limits>
+#include <thread>
+#include <vector>
+#include "array.hpp"
+#include "indexed_heap.hpp"
 #include "stream_guard.hpp"
 
 using std::pair;
 using std::string;
+using zaitsev::Array;
+using zaitsev::CompiledGraph;
+using zaitsev::ShortestPaths;
 
 constexpr int inf = std::numeric_limits< int >::max();
+constexpr long long min_distance = std::numeric_limits< int >::lowest();
+constexpr long long unreached = std::numeric_limits< long long >::max();
+constexpr size_t floyd_block_size = 64;
 
-template< typename T >
-struct Array
-{
-  Array() = delete;
-  Array(size_t size):
-    size_(size),
-    vals_(reinterpret_cast<T*>(new char[sizeof(T) * size]))
-  {}
-  Array(size_t size, const T& val):
-    size_(size),
-    vals_(reinterpret_cast< T* >(new char[sizeof(T) * size]))
-  {
-    size_t i = 0;
-    try
-    {
-      for (; i < size_; ++i)
-      {
-        new (vals_ + i) T(val);
-      }
-    }
-    catch (...)
-    {
-      for (size_t j = 0; j < i; ++j)
-      {
-        vals_[j].~T();
-      }
-      delete[] reinterpret_cast< char* >(vals_);
-      throw;
-    }
-  }
-  Array(const Array& other):
-    size_(other.size_),
-    vals_(reinterpret_cast< T* >(new char[sizeof(T) * other.size_]))
-  {
-    size_t i = 0;
-    try
-    {
-      for (; i < size_; ++i)
-      {
-        new (vals_ + i) T(other[i]);
-      }
-    }
-    catch (...)
-    {
-      for (size_t j = 0; j < i; ++j)
-      {
-        vals_[j].~T();
-      }
-      delete[] reinterpret_cast< char* >(vals_);
-      throw;
-    }
-  }
-  Array(Array&& other) noexcept:
-    size_(other.size_),
-    vals_(other.vals_)
-  {
-    other.size_ = 0;
-    other.vals_ = 0;
-  }
-  ~Array()
-  {
-    for (size_t i = 0; i < size_; ++i)
-    {
-      vals_[i].~T();
-    }
-    delete[] reinterpret_cast<char*>(vals_);
-  }
-  size_t size() const
-  {
-    return size_;
-  }
-  T* begin()
-  {
-    return vals_;
-  }
-  const T* begin() const
-  {
-    return vals_;
-  }
-  T* end()
-  {
-    return vals_ + size_;
-  }
-  const T* end() const
-  {
-    return vals_ + size_;
-  }
-  T& operator[](size_t index)
-  {
-    return vals_[index];
-  }
-  const T& operator[](size_t index) const
-  {
-    return vals_[index];
-  }
-private:
-  size_t size_;
-  T* vals_;
-};
-
-struct edge
-{
-  size_t a;
-  size_t b;
-  int val;
-};
-
-zaitsev::Map< string, size_t > convertToIndexes(const zaitsev::graph_t& graph);
-Array< Array< int > > createAdjacencyMatrix(const zaitsev::graph_t& graph);
-Array< edge > extractEdges(const zaitsev::graph_t& graph);
-Array< Array< int > > calcPathsFloyd(const zaitsev::graph_t& graph);
-pair< Array< int >, Array< size_t > > calcPathsFord(const Array< edge >& edges, size_t begin, size_t vert_nmb);
+Array< int > createAdjacencyMatrix(const CompiledGraph& graph);
+void relaxBlock(int* dist, size_t vert_nmb, size_t i_beg, size_t j_beg, size_t k_beg);
+void forEachBlock(size_t blocks_nmb, bool parallel, const std::function< void(size_t) >& relax);
+Array< int > calcPathsFloyd(const CompiledGraph& graph, bool parallel);
+size_t findPredecessorsCycle(const Array< size_t >& prev);
+size_t relaxFromQueue(const CompiledGraph& graph, Array< int >& dist, Array< size_t >& prev, Array< size_t >& queue,
+  size_t queue_size);
+pair< Array< int >, Array< size_t > > calcPathsFord(const CompiledGraph& graph, size_t begin);
+zaitsev::ForwardList< size_t > findNegativeCycle(const CompiledGraph& graph);
+pair< Array< int >, Array< size_t > > calcPathsDijkstra(const CompiledGraph& graph, size_t begin);
+pair< Array< int >, Array< size_t > > calcPaths(const CompiledGraph& graph, size_t begin);
+const zaitsev::ShortestPaths& calcCachedPaths(const zaitsev::Graph& graph, size_t begin);
+const Array< int >& calcCachedMatrix(const zaitsev::Graph& graph, bool parallel);
+std::ostream& printHitRate(std::ostream& out, const zaitsev::CacheStats& stats);
 
 void zaitsev::findShortestDistance(const base_t& graphs, const args_flist& args, std::ostream& out)
 {
@@ -139,31 +52,30 @@ void zaitsev::findShortestDistance(const base_t& graphs, const args_flist& args,
   {
     throw std::invalid_argument("Graph doesn't exist");
   }
-  graph_t::const_iterator graph_beg = graph_pos->second.find(begin_name);
-  graph_t::const_iterator graph_end = graph_pos->second.find(end_name);
-  if (graph_beg == graph_pos->second.end() || graph_end == graph_pos->second.end())
+  const CompiledGraph& graph = graph_pos->second.compiled();
+  size_t begin = graph.findIndex(begin_name);
+  size_t end = graph.findIndex(end_name);
+  if (begin == graph.size() || end == graph.size())
   {
     throw std::invalid_argument("Vertex doesn't exist");
   }
-  Map< string, size_t > indexes = convertToIndexes(graph_pos->second);
-  Array< edge > edges = extractEdges(graph_pos->second);
-  pair< Array< int >, Array< size_t > > dist_with_prev = calcPathsFord(edges, indexes[begin_name], indexes.size());
+  const ShortestPaths& paths = calcCachedPaths(graph_pos->second, begin);
 
-  if (dist_with_prev.first[indexes[begin_name]] == inf)
+  if (paths.distances[begin] == inf)
   {
     throw std::invalid_argument("Graph contains negative weight cycles");
   }
-  if (dist_with_prev.first[indexes[end_name]] == inf)
+  if (paths.distances[end] == inf)
   {
     throw std::invalid_argument("End vertex cannot be reached");
   }
-  if (dist_with_prev.first[indexes[begin_name]] == inf)
+  if (paths.distances[begin] == inf)
   {
     out << "Vertex \"" << end_name << "\" is unreachable from \"" << begin_name << "\".\n";
   }
   else
   {
-    out << dist_with_prev.first[indexes[end_name]] << '\n';
+    out << paths.distances[end] << '\n';
   }
   return;
 }
@@ -184,35 +96,35 @@ void zaitsev::findShortestPathTtrace(const base_t& graphs, const args_flist& arg
   {
     throw std::invalid_argument("Graph doesn't exist");
   }
-  const graph_t& graph = graph_pos->second;
-  if (graph.find(begin_name) == graph.end() || graph.find(end_name) == graph.end())
+  const CompiledGraph& graph = graph_pos->second.compiled();
+  size_t begin = graph.findIndex(begin_name);
+  size_t end = graph.findIndex(end_name);
+  if (begin == graph.size() || end == graph.size())
   {
     throw std::invalid_argument("Vertex doesn't exist");
   }
-  Map< string, size_t > indexes = convertToIndexes(graph);
-  Array< edge > edges = extractEdges(graph);
-  pair< Array< int >, Array< size_t > > dist_with_prev = calcPathsFord(edges, indexes[begin_name], indexes.size());
+  const ShortestPaths& paths = calcCachedPaths(graph_pos->second, begin);
 
-  if (dist_with_prev.first[indexes[begin_name]] == inf)
+  if (paths.distances[begin] == inf)
   {
     throw std::invalid_argument("Graph contains negative weight cycles");
   }
-  if (dist_with_prev.first[indexes[end_name]] == inf)
+  if (paths.distances[end] == inf)
   {
     throw std::invalid_argument("End vertex cannot be reached");
   }
-  if (dist_with_prev.first[indexes[begin_name]] == inf)
+  if (paths.distances[begin] == inf)
   {
     out << "Vertex \"" << end_name << "\" is unreachable from \"" << begin_name << "\".\n";
   }
   else
   {
     ForwardList< string >path = { end_name };
-    size_t i = indexes[end_name];
-    while (path.front() != begin_name)
+    size_t i = end;
+    while (i != begin)
     {
-      i = dist_with_prev.second[i];
-      path.push_front(std::next(graph.begin(), i)->first);
+      i = paths.previous[i];
+      path.push_front(graph.name(i));
     }
     out << path.front();
     for (auto i = ++path.begin(); i != path.end(); ++i)
@@ -227,34 +139,45 @@ void zaitsev::findShortestPathTtrace(const base_t& graphs, const args_flist& arg
 void zaitsev::printShortestPathsMatrix(const base_t& graphs, const args_flist& args, std::ostream& out)
 {
   size_t args_nmb = std::distance(args.cbegin(), args.cend());
-  if (args_nmb != 2)
+  args_flist::const_iterator arg_it = args.cbegin();
+  if (args_nmb > 3 || args_nmb < 2 || (args_nmb == 2 && (*std::next(arg_it))[0] == '-'))
   {
     throw std::invalid_argument("Invalid number of arguments");
   }
-  const std::string& arg = *(++args.cbegin());
+  bool parallel = false;
+  if (args_nmb == 3)
+  {
+    ++arg_it;
+    if (*arg_it != "-parallel")
+    {
+      throw std::invalid_argument("Invalid option");
+    }
+    parallel = true;
+  }
+  const std::string& arg = *(++arg_it);
   base_t::const_iterator it = graphs.find(arg);
   if (it == graphs.end())
   {
     throw std::invalid_argument("Graph with name \"" + arg + "\", doesn't exists.");
   }
-  if (it->second.empty())
+  const CompiledGraph& graph = it->second.compiled();
+  if (graph.size() == 0)
   {
     out << "Graph is empty.\n";
     return;
   }
-  Array< Array< int > > distances = calcPathsFloyd(it->second);
+  const Array< int >& distances = calcCachedMatrix(it->second, parallel);
   size_t max_int_len = std::to_string(std::numeric_limits< int >::lowest()).size();
-  auto get_len = [](const std::pair< string, unit_t >& a)
-    {
-      return a.first.size();
-    };
   auto need_to_extend = [&](const size_t len)
     {
       return len < max_int_len;
     };
 
-  Array< size_t > names_length(it->second.size());
-  std::transform(it->second.begin(), it->second.end(), names_length.begin(), get_len);
+  Array< size_t > names_length(graph.size());
+  for (size_t i = 0; i < graph.size(); ++i)
+  {
+    names_length[i] = graph.name(i).size();
+  }
   size_t names_column_width = *(std::max_element(names_length.begin(), names_length.end()));
   std::replace_if(names_length.begin(), names_length.end(), need_to_extend, max_int_len);
   string names_indent(names_column_width, ' ');
@@ -262,29 +185,27 @@ void zaitsev::printShortestPathsMatrix(const base_t& graphs, const args_flist& a
   StreamGuard guard(out);
 
   out << names_indent;
-  size_t i = 0;
-  for (graph_t::const_iterator ii = it->second.begin(); ii != it->second.end(); ++ii)
+  for (size_t i = 0; i < graph.size(); ++i)
   {
-    out << indent << std::left << std::setw(names_length[i]) << ii->first;
+    out << indent << std::left << std::setw(names_length[0]) << graph.name(i);
   }
   out << '\n';
-  i = 0;
-  for (graph_t::const_iterator ii = it->second.begin(); ii != it->second.end(); ++ii)
+  for (size_t i = 0; i < graph.size(); ++i)
   {
-    out << std::left << std::setw(names_column_width) << ii->first;
-    for (size_t j = 0; j < distances.size(); ++j)
+    out << std::left << std::setw(names_column_width) << graph.name(i);
+    for (size_t j = 0; j < graph.size(); ++j)
     {
-      if (distances[i][j] == inf)
+      int distance = distances[i * graph.size() + j];
+      if (distance == inf)
       {
         out << indent << std::left << std::setw(names_length[i]) << "inf";
       }
       else
       {
-        out << indent << std::left << std::setw(names_length[i]) << distances[i][j];
+        out << indent << std::left << std::setw(names_length[i]) << distance;
       }
     }
     out << '\n';
-    ++i;
   }
   return;
 }
@@ -302,118 +223,361 @@ void zaitsev::checkNegativeWeightCycles(const base_t& graphs, const args_flist&
   {
     throw std::invalid_argument("Graph with name \"" + arg + "\", doesn't exists.");
   }
-  Array< Array< int > > distances = calcPathsFloyd(it->second);
-  bool negative_cycles = false;
-  for (size_t i = 0; i < distances.size(); ++i)
+  const CompiledGraph& graph = it->second.compiled();
+  ForwardList< size_t > cycle = findNegativeCycle(graph);
+  if (cycle.empty())
   {
-    if (distances[i][i] < 0)
-    {
-      negative_cycles = true;
-      break;
-    }
+    out << "Graph doesn't contain a negative weight cycle\n";
+    return;
+  }
+  out << "Graph contains a negative weight cycle: " << graph.name(cycle.front());
+  for (auto i = ++cycle.cbegin(); i != cycle.cend(); ++i)
+  {
+    out << "->" << graph.name(*i);
   }
-  out << "Graph " << (negative_cycles ? "contains" : "doesn't contain") << " a negative weight cycle\n";
+  out << '\n';
 }
 
-zaitsev::Map< string, size_t > convertToIndexes(const zaitsev::graph_t& graph)
+void zaitsev::printCacheStats(const base_t& graphs, const args_flist& args, std::ostream& out)
 {
-  using namespace zaitsev;
-  Map< string, size_t > vert_indexes;
-  size_t index = 0;
-  for (auto& i : graph)
+  size_t args_nmb = std::distance(args.cbegin(), args.cend());
+  if (args_nmb != 1)
+  {
+    throw std::invalid_argument("Invalid number of arguments");
+  }
+  if (graphs.empty())
+  {
+    out << "No saved graphs\n";
+    return;
+  }
+  for (auto& i : graphs)
   {
-    vert_indexes[i.first] = index;
-    ++index;
+    const PathCache& cache = i.second.cache();
+    out << i.first << ": single-source ";
+    printHitRate(out, cache.pathsStats()) << ", all-pairs ";
+    printHitRate(out, cache.matrixStats()) << '\n';
   }
-  return vert_indexes;
 }
 
-Array< Array< int > > createAdjacencyMatrix(const zaitsev::graph_t& graph)
+Array< int > createAdjacencyMatrix(const CompiledGraph& graph)
 {
-  using namespace zaitsev;
-  Array< Array< int > > matrix(graph.size(), Array< int >(graph.size(), inf));
-  Map< string, size_t > vert_indexes = convertToIndexes(graph);
-
-  size_t i = 0;
-  for (auto& vert : graph)
+  size_t vert_nmb = graph.size();
+  Array< int > matrix(vert_nmb * vert_nmb, inf);
+  for (size_t i = 0; i < vert_nmb; ++i)
   {
-    for (auto& it_j : vert.second)
+    for (size_t k = graph.edgesBegin(i); k < graph.edgesEnd(i); ++k)
     {
-      matrix[i][vert_indexes[it_j.first]] = it_j.second;
+      matrix[i * vert_nmb + graph.target(k)] = graph.weight(k);
     }
-    ++i;
   }
   return matrix;
 }
 
-Array< edge > extractEdges(const zaitsev::graph_t& graph)
+size_t findPredecessorsCycle(const Array< size_t >& prev)
 {
-  using namespace zaitsev;
+  size_t vert_nmb = prev.size();
+  Array< size_t > visited_from(vert_nmb, vert_nmb);
+  for (size_t start = 0; start < vert_nmb; ++start)
+  {
+    size_t cur = start;
+    while (cur < vert_nmb && visited_from[cur] == vert_nmb)
+    {
+      visited_from[cur] = start;
+      cur = prev[cur];
+    }
+    if (cur < vert_nmb && visited_from[cur] == start)
+    {
+      return cur;
+    }
+  }
+  return vert_nmb;
+}
 
-  Map< string, size_t > vert_indexes = convertToIndexes(graph);
-  size_t edges_nmb = 0;
-  for (auto& i : graph)
+size_t relaxFromQueue(const CompiledGraph& graph, Array< int >& dist, Array< size_t >& prev, Array< size_t >& queue,
+  size_t queue_size)
+{
+  size_t vert_nmb = graph.size();
+  Array< bool > in_queue(vert_nmb, false);
+  Array< size_t > path_len(vert_nmb, 0);
+  Array< long long > distances(vert_nmb, unreached);
+  for (size_t i = 0; i < vert_nmb; ++i)
   {
-    edges_nmb += i.second.size();
+    if (dist[i] != inf)
+    {
+      distances[i] = dist[i];
+    }
   }
-  Array< edge > edges_list(edges_nmb);
-  size_t i = 0, k = 0;
-  for (auto& it_i : graph)
+  for (size_t i = 0; i < queue_size; ++i)
   {
-    for (auto& it_j : it_i.second)
+    in_queue[queue[i]] = true;
+  }
+  size_t head = 0;
+  size_t relaxations_nmb = 0;
+  while (queue_size != 0)
+  {
+    size_t a = queue[head];
+    head = (head + 1) % vert_nmb;
+    --queue_size;
+    in_queue[a] = false;
+    for (size_t j = graph.edgesBegin(a); j < graph.edgesEnd(a); ++j)
     {
-      edges_list[k] = { i, vert_indexes[it_j.first], it_j.second };
-      ++k;
+      size_t b = graph.target(j);
+      long long distance = distances[a] + graph.weight(j);
+      if (distance >= distances[b])
+      {
+        continue;
+      }
+      distances[b] = distance;
+      prev[b] = a;
+      path_len[b] = path_len[a] + 1;
+      if (path_len[b] >= vert_nmb || ++relaxations_nmb % vert_nmb == 0)
+      {
+        size_t cycle_vertex = findPredecessorsCycle(prev);
+        if (cycle_vertex != vert_nmb)
+        {
+          return cycle_vertex;
+        }
+      }
+      if (!in_queue[b])
+      {
+        queue[(head + queue_size) % vert_nmb] = b;
+        ++queue_size;
+        in_queue[b] = true;
+      }
     }
-    ++i;
   }
-  return edges_list;
+  for (size_t i = 0; i < vert_nmb; ++i)
+  {
+    dist[i] = (distances[i] >= inf) ? inf : std::max(distances[i], min_distance);
+  }
+  return vert_nmb;
+}
+
+pair< Array< int >, Array< size_t > > calcPathsFord(const CompiledGraph& graph, size_t begin)
+{
+  size_t vert_nmb = graph.size();
+  Array< int > dist(vert_nmb, inf);
+  dist[begin] = 0;
+  Array< size_t > prev(vert_nmb, vert_nmb + 1);
+  Array< size_t > queue(vert_nmb, begin);
+  if (relaxFromQueue(graph, dist, prev, queue, 1) != vert_nmb)
+  {
+    std::fill(dist.begin(), dist.end(), inf);
+  }
+  return { dist, prev };
+}
+
+zaitsev::ForwardList< size_t > findNegativeCycle(const CompiledGraph& graph)
+{
+  using zaitsev::ForwardList;
+  size_t vert_nmb = graph.size();
+  Array< int > dist(vert_nmb, 0);
+  Array< size_t > prev(vert_nmb, vert_nmb + 1);
+  Array< size_t > queue(vert_nmb, 0);
+  for (size_t i = 0; i < vert_nmb; ++i)
+  {
+    queue[i] = i;
+  }
+  ForwardList< size_t > cycle;
+  size_t cycle_vertex = relaxFromQueue(graph, dist, prev, queue, vert_nmb);
+  if (cycle_vertex == vert_nmb)
+  {
+    return cycle;
+  }
+  cycle.push_front(cycle_vertex);
+  for (size_t i = prev[cycle_vertex]; i != cycle_vertex; i = prev[i])
+  {
+    cycle.push_front(i);
+  }
+  cycle.push_front(cycle_vertex);
+  return cycle;
 }
 
-pair< Array< int >, Array< size_t > > calcPathsFord(const Array< edge >& edges, size_t begin, size_t vert_nmb)
+pair< Array< int >, Array< size_t > > calcPathsDijkstra(const CompiledGraph& graph, size_t begin)
 {
+  size_t vert_nmb = graph.size();
   Array< int > dist(vert_nmb, inf);
   dist[begin] = 0;
   Array< size_t > prev(vert_nmb, vert_nmb + 1);
-  bool changed = true;
-  size_t phase_nmb = 0;
-  while (changed && phase_nmb < vert_nmb + 1)
+  zaitsev::IndexedHeap queue(vert_nmb);
+  queue.push(begin, 0);
+  while (!queue.empty())
   {
-    changed = false;
-    for (size_t j = 0; j < edges.size(); ++j)
+    size_t a = queue.pop();
+    for (size_t j = graph.edgesBegin(a); j < graph.edgesEnd(a); ++j)
     {
-      if (dist[edges[j].a] < inf && dist[edges[j].b] > dist[edges[j].a] + edges[j].val)
+      size_t b = graph.target(j);
+      long long distance = static_cast< long long >(dist[a]) + graph.weight(j);
+      if (distance >= dist[b])
       {
-        dist[edges[j].b] = dist[edges[j].a] + edges[j].val;
-        prev[edges[j].b] = edges[j].a;
-        changed = true;
+        continue;
       }
+      dist[b] = distance;
+      prev[b] = a;
+      queue.push(b, distance);
     }
-    ++phase_nmb;
   }
-  if (phase_nmb == vert_nmb + 1)
-  {
-    std::fill(dist.begin(), dist.end(), inf);
-  }
-
   return { dist, prev };
 }
 
-Array< Array< int > > calcPathsFloyd(const zaitsev::graph_t& graph)
+pair< Array< int >, Array< size_t > > calcPaths(const CompiledGraph& graph, size_t begin)
 {
-  Array< Array< int > > dist = createAdjacencyMatrix(graph);
-  for (size_t k = 0; k < dist.size(); ++k)
+  if (graph.hasNegativeWeights())
   {
-    for (size_t i = 0; i < dist.size(); ++i)
+    return calcPathsFord(graph, begin);
+  }
+  return calcPathsDijkstra(graph, begin);
+}
+
+void relaxBlock(int* dist, size_t vert_nmb, size_t i_beg, size_t j_beg, size_t k_beg)
+{
+  size_t i_end = std::min(i_beg + floyd_block_size, vert_nmb);
+  size_t j_end = std::min(j_beg + floyd_block_size, vert_nmb);
+  size_t k_end = std::min(k_beg + floyd_block_size, vert_nmb);
+  int row_k[floyd_block_size];
+  for (size_t k = k_beg; k < k_end; ++k)
+  {
+    std::copy(dist + k * vert_nmb + j_beg, dist + k * vert_nmb + j_end, row_k);
+    for (size_t i = i_beg; i < i_end; ++i)
     {
-      for (size_t j = 0; j < dist.size(); ++j)
+      int* row_i = dist + i * vert_nmb;
+      int dist_ik = row_i[k];
+      if (dist_ik == inf)
       {
-        if (dist[i][k] < inf && dist[k][j] < inf)
+        continue;
+      }
+      if (dist_ik >= 0)
+      {
+        int high = inf - dist_ik;
+        for (size_t j = 0; j < j_end - j_beg; ++j)
         {
-          dist[i][j] = std::min(dist[i][j], dist[i][k] + dist[k][j]);
+          int sum = row_k[j] < high ? row_k[j] + dist_ik : inf;
+          row_i[j_beg + j] = std::min(row_i[j_beg + j], sum);
         }
       }
+      else
+      {
+        int low = std::numeric_limits< int >::lowest() - dist_ik;
+        for (size_t j = 0; j < j_end - j_beg; ++j)
+        {
+          int sum = row_k[j] == inf ? inf : std::max(row_k[j], low) + dist_ik;
+          row_i[j_beg + j] = std::min(row_i[j_beg + j], sum);
+        }
+      }
+    }
+  }
+}
+
+void forEachBlock(size_t blocks_nmb, bool parallel, const std::function< void(size_t) >& relax)
+{
+  size_t threads_nmb = parallel ? std::min< size_t >(std::thread::hardware_concurrency(), blocks_nmb) : 0;
+  if (threads_nmb < 2)
+  {
+    for (size_t b = 0; b < blocks_nmb; ++b)
+    {
+      relax(b);
+    }
+    return;
+  }
+  auto worker = [&](size_t first)
+    {
+      for (size_t b = first; b < blocks_nmb; b += threads_nmb)
+      {
+        relax(b);
+      }
+    };
+  std::vector< std::thread > threads;
+  threads.reserve(threads_nmb - 1);
+  try
+  {
+    for (size_t t = 1; t < threads_nmb; ++t)
+    {
+      threads.emplace_back(worker, t);
+    }
+  }
+  catch (...)
+  {
+    for (auto& thread : threads)
+    {
+      thread.join();
     }
+    throw;
+  }
+  worker(0);
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+}
+
+const zaitsev::ShortestPaths& calcCachedPaths(const zaitsev::Graph& graph, size_t begin)
+{
+  zaitsev::PathCache& cache = graph.cache();
+  const zaitsev::ShortestPaths* paths = cache.findPaths(begin);
+  if (paths)
+  {
+    return *paths;
+  }
+  pair< Array< int >, Array< size_t > > dist_with_prev = calcPaths(graph.compiled(), begin);
+  return cache.addPaths(begin, zaitsev::ShortestPaths(std::move(dist_with_prev.first), std::move(dist_with_prev.second)));
+}
+
+const Array< int >& calcCachedMatrix(const zaitsev::Graph& graph, bool parallel)
+{
+  zaitsev::PathCache& cache = graph.cache();
+  const Array< int >* matrix = cache.findMatrix();
+  if (matrix)
+  {
+    return *matrix;
+  }
+  return cache.addMatrix(calcPathsFloyd(graph.compiled(), parallel));
+}
+
+std::ostream& printHitRate(std::ostream& out, const zaitsev::CacheStats& stats)
+{
+  size_t queries_nmb = stats.hits + stats.misses;
+  out << stats.hits << '/' << queries_nmb << " hits";
+  if (queries_nmb != 0)
+  {
+    out << " (" << stats.hits * 100 / queries_nmb << "%)";
+  }
+  return out;
+}
+
+Array< int > calcPathsFloyd(const CompiledGraph& graph, bool parallel)
+{
+  size_t vert_nmb = graph.size();
+  Array< int > dist = createAdjacencyMatrix(graph);
+  int* data = dist.begin();
+  size_t blocks_nmb = (vert_nmb + floyd_block_size - 1) / floyd_block_size;
+  for (size_t kb = 0; kb < blocks_nmb; ++kb)
+  {
+    size_t k_beg = kb * floyd_block_size;
+    relaxBlock(data, vert_nmb, k_beg, k_beg, k_beg);
+    auto relax_cross = [&](size_t b)
+      {
+        if (b != kb)
+        {
+          relaxBlock(data, vert_nmb, k_beg, b * floyd_block_size, k_beg);
+          relaxBlock(data, vert_nmb, b * floyd_block_size, k_beg, k_beg);
+        }
+      };
+    forEachBlock(blocks_nmb, parallel, relax_cross);
+    auto relax_rest = [&](size_t ib)
+      {
+        if (ib == kb)
+        {
+          return;
+        }
+        for (size_t jb = 0; jb < blocks_nmb; ++jb)
+        {
+          if (jb != kb)
+          {
+            relaxBlock(data, vert_nmb, ib * floyd_block_size, jb * floyd_block_size, k_beg);
+          }
+        }
+      };
+    forEachBlock(blocks_nmb, parallel, relax_rest);
   }
   return dist;
 }
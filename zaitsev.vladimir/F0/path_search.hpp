@@ -8,5 +8,6 @@ namespace zaitsev
   void findShortestPathTtrace(const base_t& graphs, const args_flist& args, std::ostream& out);
   void printShortestPathsMatrix(const base_t& graphs, const args_flist& args, std::ostream& out);
   void checkNegativeWeightCycles(const base_t& graphs, const args_flist& args, std::ostream& out);
+  void printCacheStats(const base_t& graphs, const args_flist& args, std::ostream& out);
 }
 #endif
@@ -0,0 +1,273 @@
+#include "snapshot.hpp"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+  constexpr char snapshot_magic[8] = { 'Z', 'G', 'R', 'A', 'P', 'H', 'S', '\x1a' };
+  constexpr uint32_t snapshot_version = 1;
+  constexpr size_t header_size = sizeof(snapshot_magic) + 2 * sizeof(uint32_t) + 3 * sizeof(uint64_t);
+
+  uint64_t calcChecksum(const char* begin, const char* end)
+  {
+    uint64_t hash = 14695981039346656037ull;
+    for (; begin != end; ++begin)
+    {
+      hash ^= static_cast< unsigned char >(*begin);
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  }
+
+  template< typename T >
+  void append(std::string& buffer, T value)
+  {
+    buffer.append(reinterpret_cast< const char* >(&value), sizeof(T));
+  }
+
+  class SnapshotReader
+  {
+  public:
+    SnapshotReader(const char* begin, const char* end):
+      pos_(begin),
+      end_(end)
+    {}
+    template< typename T >
+    T read()
+    {
+      T value;
+      std::memcpy(&value, take(sizeof(T)), sizeof(T));
+      return value;
+    }
+    const char* take(size_t size)
+    {
+      if (static_cast< size_t >(end_ - pos_) < size)
+      {
+        throw std::invalid_argument("Snapshot is truncated");
+      }
+      const char* taken = pos_;
+      pos_ += size;
+      return taken;
+    }
+    bool atEnd() const
+    {
+      return pos_ == end_;
+    }
+  private:
+    const char* pos_;
+    const char* end_;
+  };
+}
+
+bool zaitsev::isSnapshot(std::istream& in)
+{
+  char magic[sizeof(snapshot_magic)] = {};
+  std::istream::pos_type start = in.tellg();
+  in.read(magic, sizeof(magic));
+  bool is_snapshot = in.gcount() == sizeof(magic) && std::memcmp(magic, snapshot_magic, sizeof(magic)) == 0;
+  in.clear();
+  in.seekg(start);
+  return is_snapshot;
+}
+
+void zaitsev::writeSnapshot(std::ostream& out, base_t::const_iterator begin, base_t::const_iterator end)
+{
+  Map< std::string, uint32_t > ids;
+  for (auto it = begin; it != end; ++it)
+  {
+    ids[it->first];
+    const CompiledGraph& graph = it->second.compiled();
+    for (size_t i = 0; i < graph.size(); ++i)
+    {
+      ids[graph.name(i)];
+    }
+  }
+  std::string payload;
+  uint32_t id = 0;
+  uint64_t strings_end = 0;
+  for (auto& i : ids)
+  {
+    i.second = id++;
+    strings_end += i.first.size();
+    append< uint64_t >(payload, strings_end);
+  }
+  for (auto& i : ids)
+  {
+    payload += i.first;
+  }
+  uint32_t graphs_nmb = 0;
+  for (auto it = begin; it != end; ++it)
+  {
+    const CompiledGraph& graph = it->second.compiled();
+    append< uint32_t >(payload, ids[it->first]);
+    append< uint32_t >(payload, graph.size());
+    append< uint64_t >(payload, graph.edgesNumber());
+    for (size_t i = 0; i < graph.size(); ++i)
+    {
+      append< uint32_t >(payload, ids[graph.name(i)]);
+    }
+    for (size_t i = 0; i <= graph.size(); ++i)
+    {
+      append< uint64_t >(payload, graph.edgesBegin(i));
+    }
+    for (size_t i = 0; i < graph.edgesNumber(); ++i)
+    {
+      append< uint32_t >(payload, graph.target(i));
+    }
+    for (size_t i = 0; i < graph.edgesNumber(); ++i)
+    {
+      append< int32_t >(payload, graph.weight(i));
+    }
+    ++graphs_nmb;
+  }
+  std::string header(snapshot_magic, sizeof(snapshot_magic));
+  append< uint32_t >(header, snapshot_version);
+  append< uint32_t >(header, graphs_nmb);
+  append< uint64_t >(header, ids.size());
+  append< uint64_t >(header, payload.size());
+  append< uint64_t >(header, calcChecksum(payload.data(), payload.data() + payload.size()));
+  out.write(header.data(), header.size());
+  out.write(payload.data(), payload.size());
+  if (!out)
+  {
+    throw std::ios_base::failure("Snapshot write fail");
+  }
+}
+
+zaitsev::base_t zaitsev::readSnapshot(std::istream& in)
+{
+  char header_data[header_size] = {};
+  if (!in.read(header_data, header_size))
+  {
+    throw std::invalid_argument("Snapshot is truncated");
+  }
+  SnapshotReader header(header_data, header_data + header_size);
+  if (std::memcmp(header.take(sizeof(snapshot_magic)), snapshot_magic, sizeof(snapshot_magic)) != 0)
+  {
+    throw std::invalid_argument("File is not a graph snapshot");
+  }
+  if (header.read< uint32_t >() != snapshot_version)
+  {
+    throw std::invalid_argument("Unsupported snapshot version");
+  }
+  uint32_t graphs_nmb = header.read< uint32_t >();
+  uint64_t strings_nmb = header.read< uint64_t >();
+  uint64_t payload_size = header.read< uint64_t >();
+  uint64_t checksum = header.read< uint64_t >();
+
+  std::istream::pos_type payload_start = in.tellg();
+  in.seekg(0, std::ios::end);
+  if (static_cast< uint64_t >(in.tellg() - payload_start) != payload_size)
+  {
+    throw std::invalid_argument("Snapshot size mismatch");
+  }
+  in.seekg(payload_start);
+  std::string payload(payload_size, '\0');
+  if (!in.read(&payload[0], payload_size))
+  {
+    throw std::invalid_argument("Snapshot is truncated");
+  }
+  if (calcChecksum(payload.data(), payload.data() + payload.size()) != checksum)
+  {
+    throw std::invalid_argument("Snapshot checksum mismatch");
+  }
+  if (strings_nmb > payload_size / sizeof(uint64_t))
+  {
+    throw std::invalid_argument("Snapshot is truncated");
+  }
+  SnapshotReader reader(payload.data(), payload.data() + payload.size());
+  const char* strings_ends = reader.take(strings_nmb * sizeof(uint64_t));
+  uint64_t strings_size = 0;
+  if (strings_nmb != 0)
+  {
+    std::memcpy(&strings_size, strings_ends + (strings_nmb - 1) * sizeof(uint64_t), sizeof(uint64_t));
+  }
+  const char* strings = reader.take(strings_size);
+  auto get_string = [&](uint32_t id)
+    {
+      if (id >= strings_nmb)
+      {
+        throw std::invalid_argument("Snapshot string id is out of range");
+      }
+      uint64_t str_begin = 0;
+      uint64_t str_end = 0;
+      if (id != 0)
+      {
+        std::memcpy(&str_begin, strings_ends + (id - 1) * sizeof(uint64_t), sizeof(uint64_t));
+      }
+      std::memcpy(&str_end, strings_ends + id * sizeof(uint64_t), sizeof(uint64_t));
+      if (str_begin > str_end || str_end > strings_size)
+      {
+        throw std::invalid_argument("Snapshot string table is corrupted");
+      }
+      return std::string(strings + str_begin, strings + str_end);
+    };
+
+  base_t graphs;
+  for (uint32_t g = 0; g < graphs_nmb; ++g)
+  {
+    std::string graph_name = get_string(reader.read< uint32_t >());
+    uint32_t vertices_nmb = reader.read< uint32_t >();
+    uint64_t edges_nmb = reader.read< uint64_t >();
+    if (vertices_nmb > payload_size / (sizeof(uint32_t) + sizeof(uint64_t)))
+    {
+      throw std::invalid_argument("Snapshot is truncated");
+    }
+    if (edges_nmb > payload_size / (sizeof(uint32_t) + sizeof(int32_t)))
+    {
+      throw std::invalid_argument("Snapshot is truncated");
+    }
+    Array< std::string > names(vertices_nmb, std::string());
+    for (uint32_t i = 0; i < vertices_nmb; ++i)
+    {
+      names[i] = get_string(reader.read< uint32_t >());
+      if (i != 0 && !(names[i - 1] < names[i]))
+      {
+        throw std::invalid_argument("Snapshot vertices are not sorted");
+      }
+    }
+    Array< size_t > offsets(vertices_nmb + 1, 0);
+    for (uint32_t i = 0; i <= vertices_nmb; ++i)
+    {
+      offsets[i] = reader.read< uint64_t >();
+      if ((i == 0 && offsets[i] != 0) || (i != 0 && offsets[i] < offsets[i - 1]) || offsets[i] > edges_nmb)
+      {
+        throw std::invalid_argument("Snapshot edge offsets are corrupted");
+      }
+    }
+    if (offsets[vertices_nmb] != edges_nmb)
+    {
+      throw std::invalid_argument("Snapshot edge offsets are corrupted");
+    }
+    const char* targets_data = reader.take(edges_nmb * sizeof(uint32_t));
+    const char* weights_data = reader.take(edges_nmb * sizeof(int32_t));
+    Array< size_t > targets(edges_nmb, 0);
+    Array< int > weights(edges_nmb, 0);
+    for (uint64_t i = 0; i < edges_nmb; ++i)
+    {
+      uint32_t target = 0;
+      int32_t weight = 0;
+      std::memcpy(&target, targets_data + i * sizeof(uint32_t), sizeof(uint32_t));
+      std::memcpy(&weight, weights_data + i * sizeof(int32_t), sizeof(int32_t));
+      if (target >= vertices_nmb)
+      {
+        throw std::invalid_argument("Snapshot edge target is out of range");
+      }
+      targets[i] = target;
+      weights[i] = weight;
+    }
+    if (graphs.find(graph_name) != graphs.end())
+    {
+      throw std::invalid_argument("Snapshot contains duplicate graph names");
+    }
+    CompiledGraph graph(std::move(names), std::move(offsets), std::move(targets), std::move(weights));
+    graphs[graph_name] = Graph(std::move(graph));
+  }
+  if (!reader.atEnd())
+  {
+    throw std::invalid_argument("Snapshot has trailing data");
+  }
+  return graphs;
+}
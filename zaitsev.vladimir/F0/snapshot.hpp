@@ -0,0 +1,13 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+#include <istream>
+#include <ostream>
+#include "graphs_base.hpp"
+
+namespace zaitsev
+{
+  bool isSnapshot(std::istream& in);
+  void writeSnapshot(std::ostream& out, base_t::const_iterator begin, base_t::const_iterator end);
+  base_t readSnapshot(std::istream& in);
+}
+#endif